@@ -1,11 +1,21 @@
 #pragma once
 
-#include <vector>
+#include <array>
+#include <cstdint>
 
 const int CHUNK_SIZE = 16;
+const int CHUNK_SHIFT = 4;              // 월드 타일 좌표 >> CHUNK_SHIFT = 청크 좌표 (음수도 내림)
+const int CHUNK_MASK = CHUNK_SIZE - 1;  // 월드 타일 좌표 & CHUNK_MASK = 청크 안 좌표
+static_assert(CHUNK_SIZE == (1 << CHUNK_SHIFT), "CHUNK_SIZE must be a power of two");
+
+// 벽 ID (0 = 바닥). 타일 하나당 1바이트면 충분하다
+using Tile = uint8_t;
 
 struct Chunk {
-    std::vector<std::vector<int>> tiles;
+    // tiles[y][x]: 16x16 타일을 청크 안에 연속으로 저장 (별도 힙 할당 없음)
+    std::array<std::array<Tile, CHUNK_SIZE>, CHUNK_SIZE> tiles;
 
-    Chunk() : tiles(CHUNK_SIZE, std::vector<int>(CHUNK_SIZE, 1)) {} // Default to all walls
+    Chunk() { // Default to all walls
+        for (auto& row : tiles) row.fill(1);
+    }
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Chunk.h"
+#include "IndexedHeap.h"
+#include "Pathfinder.h"
+
+class Map;
+
+// 계층 경로 탐색(HPA*)의 추상 그래프.
+// 청크 하나가 클러스터이고, 인접 청크와 맞닿은 경계에서 양쪽이 모두 열린 구간마다 진입점을 둔다.
+// 청크별로 진입점 목록과 진입점 간 청크 내부 거리를 캐시하며, 청크나 네 이웃의 리비전이 바뀌면 다시 만든다.
+class ChunkGraph {
+public:
+    // 한 번의 추상 탐색에서 만들 수 있는 최대 노드 수 (로드된 영역 안에서 긴 추격도 충분한 크기)
+    static constexpr int MAX_ABSTRACT_NODES = 16384;
+    // 캐시가 이 크기를 넘으면 더 이상 로드되어 있지 않은 청크의 항목을 정리
+    static constexpr size_t MAX_CACHED_CLUSTERS = 4096;
+
+    ChunkGraph();
+
+    // 시작점에서 목적지까지 진입점을 거치는 추상 경로를 찾아 waypoints에 양 끝을 포함해 기록한다.
+    // 연속한 두 점은 서로 인접하거나 같은 청크 안에 있어 그 청크 안에서만 이어진다.
+    bool findAbstractPath(int startX, int startY, int endX, int endY, const Map* map, std::vector<PathPoint>& waypoints);
+
+    size_t getCachedClusterCount() const { return clusters.size(); }
+
+private:
+    // 청크 안의 진입점 타일과 경계 건너편의 짝 타일 (둘은 직선으로 인접)
+    struct Entrance {
+        int x, y;
+        int partnerX, partnerY;
+    };
+
+    struct Cluster {
+        uint32_t revisions[5] = {}; // 자신, 서, 동, 북, 남 청크의 리비전
+        std::vector<Entrance> entrances;
+        std::vector<float> distances; // entrances.size()^2, 도달 불가면 무한대
+
+        // 탐색 중 상태: searchId가 현재 탐색과 같으면 리비전 확인이 끝났고 searchNodes가 유효
+        uint32_t searchId = 0;
+        std::vector<int> searchNodes; // 진입점 -> 탐색 노드 번호 (-1이면 아직 없음)
+    };
+
+    // 추상 그래프 노드: 클러스터의 진입점 하나, 또는 임시로 끼운 시작점/목적지 (entrance == -1)
+    struct SearchNode {
+        int x, y;
+        float gCost;
+        int parent;
+        bool closed;
+        Cluster* cluster;
+        int entrance;
+    };
+
+    // 청크의 클러스터 정보 (리비전이 바뀌었으면 다시 만든다). 로드되지 않은 청크면 nullptr
+    Cluster* getCluster(const Map* map, int chunkX, int chunkY);
+    void buildCluster(const Map* map, int chunkX, int chunkY, Cluster& cluster);
+    void pruneClusters(const Map* map);
+
+    // 청크 안에서만 움직이는 다익스트라. out[로컬 y * CHUNK_SIZE + 로컬 x]에 거리 기록
+    void chunkDistances(const Chunk& chunk, int localX, int localY, float* out);
+
+    int addNode(int x, int y, Cluster* cluster, int entrance);
+    int entranceNode(Cluster* cluster, int entrance);
+    void relax(int from, int to, float cost, int endX, int endY);
+
+    std::unordered_map<uint64_t, Cluster> clusters;
+
+    // 탐색 작업 메모리 (호출 간 재사용)
+    uint32_t searchId;
+    std::vector<SearchNode> nodes;
+    IndexedHeap openSet;
+    IndexedHeap localOpen;
+    float startDistances[CHUNK_SIZE * CHUNK_SIZE];
+    float endDistances[CHUNK_SIZE * CHUNK_SIZE];
+    float entranceDistances[CHUNK_SIZE * CHUNK_SIZE];
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Chunk.h"
+
+class MapGenerator;
+class RegionStore;
+
+// 백그라운드 청크 생성기.
+// 메인 스레드가 요청을 넣으면 워커가 플레이어와 가깝고 바라보는 방향에 있는 청크부터 생성하고,
+// 완성된 청크는 락 없는 단일 생산자/단일 소비자 링 버퍼로 메인 스레드에 넘긴다.
+class ChunkStreamer {
+public:
+    struct ReadyChunk {
+        int chunkX, chunkY;
+        bool fromStore; // 저장소에서 읽었으면 true, 새로 생성했으면 false
+        Chunk chunk;
+    };
+
+    explicit ChunkStreamer(const MapGenerator& generator);
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    // 생성 순서의 기준점 (청크 단위 좌표와 바라보는 방향의 단위 벡터)
+    void setFocus(float chunkX, float chunkY, float headingX, float headingY);
+    void request(int chunkX, int chunkY);
+    // 설정하면 생성하기 전에 저장소에서 먼저 찾는다
+    void setRegionStore(RegionStore* store);
+
+    // 메인 스레드 전용: 완성된 청크를 하나 꺼내 본다. 다 읽었으면 popReady()
+    const ReadyChunk* peekReady() const;
+    void popReady();
+
+private:
+    struct Request {
+        int chunkX, chunkY;
+    };
+
+    void workerLoop();
+    float priority(const Request& request) const;
+
+    static const unsigned int READY_CAPACITY = 64; // 2의 거듭제곱
+
+    const MapGenerator& generator;
+    std::thread worker;
+
+    // 요청 목록과 기준점은 mutex로 보호
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::vector<Request> requests;
+    float focusX, focusY, headingX, headingY;
+    RegionStore* regionStore;
+    bool stopping;
+
+    // 완성된 청크 링 버퍼: 워커만 writeIndex를, 메인 스레드만 readIndex를 증가시킨다
+    std::vector<ReadyChunk> ready;
+    std::atomic<unsigned int> readIndex;
+    std::atomic<unsigned int> writeIndex;
+};
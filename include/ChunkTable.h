@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Chunk.h"
+
+// 청크 좌표 -> 청크 오픈 어드레싱 해시 테이블 (선형 탐사).
+// 키는 두 좌표를 64비트 하나로 묶은 값이고, 청크는 별도로 할당되어 테이블이 커져도 주소가 바뀌지 않는다.
+class ChunkTable {
+public:
+    ChunkTable();
+
+    static uint64_t packKey(int chunkX, int chunkY) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+    }
+    static int unpackX(uint64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key >> 32)); }
+    static int unpackY(uint64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key)); }
+
+    const Chunk* find(int chunkX, int chunkY) const;
+    Chunk* find(int chunkX, int chunkY);
+
+    // 없으면 기본값(전부 벽)으로 새로 만든다
+    Chunk& insert(int chunkX, int chunkY);
+    // 제거한 청크의 메모리는 다음 insert에서 재사용된다
+    bool erase(int chunkX, int chunkY);
+
+    // 청크별 마지막 사용 시점 (LRU 제거용)
+    void touch(int chunkX, int chunkY, uint32_t tick);
+
+    // 청크 내용이 바뀔 때마다 새 값을 받는 리비전 (없는 청크는 0)
+    void setRevision(int chunkX, int chunkY, uint32_t revision);
+    uint32_t getRevision(int chunkX, int chunkY) const;
+
+    // func(chunkX, chunkY, lastUsedTick)
+    template <typename Func>
+    void forEach(Func func) const {
+        for (const Slot& slot : slots) {
+            if (slot.chunk) func(unpackX(slot.key), unpackY(slot.key), slot.lastUsed);
+        }
+    }
+
+    int size() const { return count; }
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        uint32_t lastUsed = 0;
+        uint32_t revision = 0;
+        std::unique_ptr<Chunk> chunk; // nullptr이면 빈 슬롯
+    };
+
+    static uint64_t hashKey(uint64_t key);
+    int findSlot(uint64_t key) const;
+    void grow();
+
+    std::vector<Slot> slots;
+    std::vector<std::unique_ptr<Chunk>> spareChunks;
+    uint64_t mask;
+    int count;
+};
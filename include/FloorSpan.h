@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+
+// 바닥/천장 한 행(span)을 그리는 커널.
+// 바닥과 천장은 같은 월드 좌표를 공유하므로 한 번의 좌표 계산으로 두 행을 함께 채운다.
+// 텍스처 크기는 2의 거듭제곱이어야 한다 (좌표를 마스크로 감싼다).
+struct FloorSpanParams {
+    const uint32_t* floorPixels;
+    int floorWidthLog2, floorHeightLog2;
+    const uint32_t* ceilingPixels;
+    int ceilingWidthLog2, ceilingHeightLog2;
+
+    // 픽셀 i의 월드 좌표는 (startX + i * stepX, startY + i * stepY)
+    float startX, startY;
+    float stepX, stepY;
+
+    // 8.8 고정소수점 밝기 (256 = 1.0). 채널값은 (c * lightLevel) >> 8 로 스케일되고 알파는 유지된다.
+    int lightLevel;
+    // 픽셀별 밝기 (같은 8.8 형식, count개). nullptr이면 모든 픽셀에 lightLevel을 쓴다
+    const uint16_t* lightLevels;
+
+    int count;
+    uint32_t* floorOut;
+    uint32_t* ceilingOut;
+};
+
+enum class SpanKernel {
+    Scalar, // 기준 구현 (정확성 비교용)
+    SSE2,   // 4픽셀 단위
+    AVX2    // 8픽셀 단위, gather 사용
+};
+
+using FloorSpanFunc = void (*)(const FloorSpanParams& span);
+
+// 현재 CPU에서 쓸 수 있는 가장 넓은 커널
+SpanKernel detectSpanKernel();
+bool isSpanKernelSupported(SpanKernel kernel);
+FloorSpanFunc getFloorSpanKernel(SpanKernel kernel);
+const char* getSpanKernelName(SpanKernel kernel);
+
+// 임의의 span들을 두 커널로 그려 서로 다른 픽셀 수를 반환 (0이면 동일)
+int compareFloorSpanKernels(SpanKernel kernel, SpanKernel reference, int spanCount);
+
+// float 조명용 스칼라 커널 (LightingMode::Float). span의 lightLevel/lightLevels 대신
+// 밝기 lighting과 픽셀별 밝기 pixelLighting (count개, nullptr이면 모든 픽셀에 lighting)을 쓴다
+void floorSpanFloat(const FloorSpanParams& span, float lighting, const float* pixelLighting);
+
+// 8.8 고정소수점 밝기로 ARGB 색을 스케일 (커널과 동일한 연산)
+inline uint32_t shadeColorFixed(uint32_t color, int lightLevel) {
+    uint32_t r = (((color >> 16) & 0xFF) * lightLevel) >> 8;
+    uint32_t g = (((color >> 8) & 0xFF) * lightLevel) >> 8;
+    uint32_t b = ((color & 0xFF) * lightLevel) >> 8;
+    return (color & 0xFF000000) | (r << 16) | (g << 8) | b;
+}
+
+// float 밝기로 ARGB 색을 스케일: 0~1로 자른 뒤 채널마다 곱하고 절삭 (알파는 유지)
+inline uint32_t shadeColorFloat(uint32_t color, float lighting) {
+    lighting = lighting < 0.0f ? 0.0f : (lighting > 1.0f ? 1.0f : lighting);
+    uint32_t r = static_cast<uint32_t>(((color >> 16) & 0xFF) * lighting);
+    uint32_t g = static_cast<uint32_t>(((color >> 8) & 0xFF) * lighting);
+    uint32_t b = static_cast<uint32_t>((color & 0xFF) * lighting);
+    return (color & 0xFF000000) | (r << 16) | (g << 8) | b;
+}
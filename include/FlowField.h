@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+// 플레이어 타일을 목표로 하는 거리 지도(Dijkstra map).
+// 플레이어 주변 정사각형 창 안의 모든 타일에 대해 플레이어까지의 최단 거리와 다음으로 갈 방향을 한 번에 계산해 두고,
+// 몬스터는 자기 타일의 방향만 읽는다 (몬스터 수와 무관한 비용).
+// 이동 비용은 직선 2, 대각선 3의 정수라서 버킷 큐(Dial 알고리즘)로 선형 시간에 채운다.
+class FlowField {
+public:
+    // 플레이어를 중심으로 한 창의 반경 (타일)
+    static constexpr int FIELD_RADIUS = 48;
+    static constexpr int FIELD_SIZE = FIELD_RADIUS * 2 + 1;
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+    FlowField();
+
+    // 플레이어 타일이 바뀌었거나 창 안의 청크가 로드/수정되었을 때만 다시 계산한다. 다시 계산했으면 true
+    bool update(const Map* map, float playerX, float playerY);
+
+    // (x, y) 위치에서 플레이어 쪽으로 가는 다음 타일 중앙을 향한 단위 벡터.
+    // 창 밖이거나 도달할 수 없거나 이미 플레이어 타일이면 false
+    bool getDirection(float x, float y, float& dirX, float& dirY) const;
+
+    // 타일에서 플레이어까지의 거리 (직선 한 칸 = 2). 창 밖이거나 도달 불가면 UNREACHABLE
+    uint16_t getDistance(int tileX, int tileY) const;
+
+    int getRebuildCount() const { return rebuildCount; }
+
+private:
+    void rebuild(const Map* map);
+    uint32_t windowRevision(const Map* map) const;
+
+    int targetX, targetY;   // 플레이어 타일
+    int originX, originY;   // 창의 왼쪽 위 타일
+    uint32_t revision;      // 창을 덮는 청크 리비전의 해시 (지형이 바뀌었는지 확인용)
+    bool valid;
+    int rebuildCount;
+
+    std::vector<uint16_t> distance;
+    std::vector<uint8_t> flow;   // 다음 칸 방향 (NEIGHBOR 인덱스), 없으면 NO_FLOW
+    std::vector<uint8_t> blocked;
+    std::vector<int> buckets[4]; // 비용 mod 4 버킷 (한 번에 최대 3씩 늘어나므로 4개면 충분)
+};
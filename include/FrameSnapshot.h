@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// 스프라이트 종류: 0~5는 아이템 텍스처 (ItemType - 1)
+const int8_t SPRITE_KIND_MONSTER = 6;
+
+// 시야 안에 있을 수 있는 아이템/몬스터 하나. 렌더러는 직전/현재 스텝 위치를 보간해 그린다
+struct SpriteState {
+    float x, y;
+    float previousX, previousY;
+    float lift;   // 바닥에서 떠 있는 높이 (타일 단위)
+    int8_t kind;
+};
+
+// 시뮬레이션 한 프레임의 결과 중 렌더러, HUD, 오디오가 읽는 부분.
+// 파이프라인 모드에서는 두 개를 번갈아 쓴다: 시뮬레이션 스레드가 한쪽을 채우는 동안 메인 스레드는 다른 쪽을 그린다.
+struct FrameSnapshot {
+    float playerX = 0.0f, playerY = 0.0f, playerAngle = 0.0f;
+    float previousPlayerX = 0.0f, previousPlayerY = 0.0f, previousPlayerAngle = 0.0f;
+    float interpolation = 0.0f; // 마지막 스텝 이후 남은 시간 / 스텝 길이 (0~1)
+    std::vector<SpriteState> sprites;
+
+    // HUD
+    int health = 0, ammo = 0;
+    bool hasRedKey = false, hasBlueKey = false, hasYellowKey = false;
+
+    // 메인 스레드에서 재생할 소리
+    bool playerMoving = false;
+    int itemsCollected = 0;      // 이 프레임 동안 주운 아이템 수
+    int monsterCount = 0;
+    float nearestMonsterDistance = 0.0f;
+};
@@ -12,8 +12,38 @@ const int WINDOW_HEIGHT = 600;
 #include "LightSystem.h"
 #include "AudioManager.h"
 #include "ItemManager.h"
-#include "Monster.h"
+#include "MonsterSystem.h"
 #include "Pathfinder.h"
+#include "SpatialGrid.h"
+#include "FrameSnapshot.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// 실행 옵션 (명령줄 인자로 설정)
+struct GameOptions {
+    WallCaster wallCaster = WallCaster::DDA;
+    int renderThreads = 0; // 0: CPU 코어 수만큼 사용
+    SpanKernel spanKernel = detectSpanKernel();
+    LightingMode lightingMode = DEFAULT_LIGHTING_MODE;
+    bool mipmapping = true;
+    int chunkBudget = 0;   // 상주 청크 최대 개수, 0: 기본값
+    bool fixedSeed = false;
+    unsigned int seed = 0;
+    bool persistChunks = false; // <mapDirectory>/seed_<시드>/ 에 청크 저장 (--persist)
+    std::string mapDirectory;   // 비어 있으면 사용자 데이터 폴더(SDL_GetPrefPath)의 maps/
+    int monsterCount = 32;     // 플레이어 주변에 유지할 몬스터 수
+    bool vsync = true;
+    int maxFPS = 0;            // 화면 프레임 상한, 0: 제한 없음 (VSync가 켜져 있으면 화면 주사율)
+    bool pipelined = false;    // 다음 프레임 시뮬레이션을 별도 스레드에서 이번 프레임 렌더링과 겹쳐 실행
+};
+
+// 시뮬레이션 스텝에 적용할 누르고 있는 키 (메인 스레드에서 프레임마다 읽어 넘긴다)
+struct MovementInput {
+    bool forward = false, backward = false;
+    bool strafeLeft = false, strafeRight = false;
+    bool turnLeft = false, turnRight = false;
+};
 
 class Game {
 private:
@@ -28,10 +58,13 @@ private:
     LightSystem* lightSystem;
     AudioManager* audioManager;
     ItemManager* itemManager;
+    SpatialGrid* entityGrid;  // 아이템/몬스터 공간 색인 (수집 판정, 스냅샷에 담을 스프라이트 선별)
+    MonsterSystem* monsterSystem;
+    GameOptions options;
     
     // FPS Calculation
     Uint32 frameCount;
-    Uint32 fpsTimer;
+    Uint64 fpsTimer;      // SDL_GetPerformanceCounter 단위
     float currentFPS;
     
     // 키 입력 상태 추적
@@ -41,22 +74,67 @@ private:
     // 이동 상태 추적 (발자국 소리용)
     bool isMoving;
     bool wasMoving;
+    MovementInput movementInput;   // 이번 프레임에 읽은 이동 키
+    int itemsCollected;            // 마지막 스냅샷 이후 주운 아이템 수
     
-    // 타이밍 관련
-    Uint32 lastFrameTime;
+    // 타이밍 관련: 시뮬레이션은 SIMULATION_STEP 고정 간격으로, 화면은 가능한 만큼 자주 그린다
+    static constexpr double SIMULATION_STEP = 1.0 / 120.0;
+    static constexpr double MAX_FRAME_TIME = 0.25; // 한 프레임에 따라잡을 최대 시간 (넘으면 시뮬레이션이 느려진다)
+    Uint64 lastFrameCounter;
+    double simulationAccumulator;  // 아직 시뮬레이션하지 않은 시간 (초)
+
+    // 화면 보간용 직전 스텝의 플레이어 상태
+    float previousPlayerX, previousPlayerY, previousPlayerAngle;
+
+    // 시뮬레이션 결과는 스냅샷 두 개를 번갈아 채운다. 메인 스레드는 snapshots[renderSnapshot]만 읽는다.
+    // 파이프라인 모드에서는 시뮬레이션 스레드가 다른 쪽을 채우는 동안 플레이어/몬스터/아이템/공간 색인을 혼자 쓰고,
+    // 메인 스레드는 맵과 조명을 읽기만 한다. 맵/조명 변경은 둘이 만나는 동기화 지점(synchronizeWorld)에서만 한다.
+    static constexpr float SPRITE_CAPTURE_RADIUS = 21.0f; // 렌더러 사거리(20) + 스프라이트 폭
+    FrameSnapshot snapshots[2];
+    int renderSnapshot;
+    std::vector<int> captureResults; // 공간 색인 질의 결과 버퍼
+
+    // 플레이어에게 가장 가까운 몬스터 몇 마리는 희미하게 빛나 주변 바닥/천장을 밝힌다 (점광원 격자).
+    // 광원은 타일 중앙에 두어 몬스터가 타일을 옮길 때만 다시 계산된다
+    static constexpr int MONSTER_LIGHT_COUNT = 4;
+    static constexpr float MONSTER_LIGHT_RADIUS = 3.0f;
+    static constexpr float MONSTER_LIGHT_INTENSITY = 0.4f;
+    std::vector<int> monsterLights;          // 사용 중인 점광원 ID
+    std::vector<const SpriteState*> nearestMonsters;
+    std::thread simulationThread;
+    std::mutex simulationMutex;
+    std::condition_variable simulationCondition;
+    bool simulationPending;        // 맡긴 프레임을 시뮬레이션 스레드가 아직 처리 중
+    bool simulationStopping;
+    double pendingFrameTime;       // 시뮬레이션 스레드에 넘긴 프레임 시간과 입력
+    MovementInput pendingInput;
     
 public:
     Game();
     ~Game();
     
-    bool initialize(const std::string& resourcePath);
+    bool initialize(const std::string& resourcePath, const GameOptions& gameOptions = GameOptions());
     void run();
-    void handleEvents(float deltaTime);
+    void handleEvents();
+    // frameTime만큼 고정 스텝으로 시뮬레이션하고 결과를 snapshot에 담는다. SDL을 호출하지 않는다
+    void simulateFrame(double frameTime, const MovementInput& input, FrameSnapshot& snapshot);
+    void stepSimulation(float deltaTime, const MovementInput& input);
     void update(float deltaTime);
-    void render();
+    void render(const FrameSnapshot& snapshot);
     void cleanup();
     void calculateFPS();
     
 private:
     void loadCustomSounds(const std::string& resourcePath); // 커스텀 사운드 로딩
+    void processMovement(float deltaTime, const MovementInput& input);
+    void captureSnapshot(FrameSnapshot& snapshot);
+    // 메인 스레드 전용: 스냅샷의 소리/HUD 반영, 맵 청크 로드와 점광원 갱신
+    void applySnapshot(const FrameSnapshot& snapshot);
+    void synchronizeWorld(const FrameSnapshot& snapshot);
+    void updateMonsterLights(const FrameSnapshot& snapshot);
+    void simulationLoop();
+    void startSimulation(double frameTime);
+    void waitForSimulation();
+    void stopSimulation();
+    void waitForNextFrame(Uint64 frameStart);
 };
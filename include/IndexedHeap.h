@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+
+// 정수 ID(0 ~ capacity-1)를 float 키로 정렬하는 이진 최소 힙.
+// ID별 힙 위치를 기억하므로 decreaseKey가 O(log n)이고 중복 삽입이 없다.
+class IndexedHeap {
+public:
+    IndexedHeap() {}
+
+    // 용량을 늘린다 (줄이지는 않음). 힙에 원소가 있어도 호출할 수 있다
+    void reserve(int capacity);
+    // 남아 있는 원소만 지운다 (용량 전체를 초기화하지 않음)
+    void clear();
+
+    bool empty() const { return items.empty(); }
+    int size() const { return static_cast<int>(items.size()); }
+    bool contains(int id) const { return position[id] >= 0; }
+
+    void push(int id, float key);
+    // key가 현재보다 작을 때만 호출
+    void decreaseKey(int id, float key);
+    int top() const { return items[0].id; }
+    float topKey() const { return items[0].key; }
+    int pop();
+
+private:
+    struct Item {
+        int id;
+        float key;
+    };
+
+    void siftUp(int index);
+    void siftDown(int index);
+    void place(int index, const Item& item) {
+        items[index] = item;
+        position[item.id] = index;
+    }
+
+    std::vector<Item> items;
+    std::vector<int> position; // ID -> items 인덱스, 힙에 없으면 -1
+};
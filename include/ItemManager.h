@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 
+class SpatialGrid;
+
 enum class ItemType {
     KEY_RED = 1,
     KEY_BLUE = 2,
@@ -16,26 +18,33 @@ struct Item {
     ItemType type;        // 아이템 종류
     bool collected;       // 수집 여부
     float animationTime;  // 애니메이션용 시간
+    int spatialHandle;    // SpatialGrid 핸들 (수집되면 색인에서 빠지고 -1)
     
     Item(float posX, float posY, ItemType itemType) 
-        : x(posX), y(posY), type(itemType), collected(false), animationTime(0.0f) {}
+        : x(posX), y(posY), type(itemType), collected(false), animationTime(0.0f), spatialHandle(-1) {}
 };
 
 class ItemManager {
 private:
     std::vector<Item> items;
+    SpatialGrid* grid;            // 수집되지 않은 아이템만 등록 (userData = items 인덱스)
+    std::vector<int> queryResults; // 질의 결과 버퍼 재사용
     int redKeys, blueKeys, yellowKeys;
     int health, ammo;
     
 public:
-    ItemManager();
+    explicit ItemManager(SpatialGrid* grid);
     ~ItemManager();
     
     // 아이템 관리
     void addItem(float x, float y, ItemType type);
     void clearItems();
+    // 플레이어 주변 칸의 아이템만 검사한다
     bool checkItemCollision(float playerX, float playerY, float radius = 0.3f);
-    void update(float deltaTime);
+    // 보이는 범위 (ANIMATION_RADIUS) 안의 아이템만 애니메이션을 진행한다
+    void update(float deltaTime, float playerX, float playerY);
+
+    static constexpr float ANIMATION_RADIUS = 20.0f;
     
     // 아이템 상태 조회
     const std::vector<Item>& getItems() const { return items; }
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 고정된 워커 스레드 풀. 렌더러가 프레임마다 화면을 열/행 단위로 나눠 병렬 처리할 때 사용한다.
+// 스레드는 생성 시 한 번만 만들어지고 소멸 시까지 재사용된다.
+class JobSystem {
+public:
+    // threadCount는 호출 스레드를 포함한 전체 스레드 수. 1 이하이면 워커 없이 호출 스레드에서 실행한다.
+    explicit JobSystem(int threadCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // [0, count) 범위를 grain 크기의 작업으로 나누어 func(begin, end)를 실행하고, 모두 끝날 때까지 대기
+    void parallelFor(int count, int grain, const std::function<void(int, int)>& func);
+
+    int getThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    // 0 이하를 넘기면 사용할 스레드 수를 CPU 코어 수로 결정
+    static int resolveThreadCount(int requested);
+
+private:
+    void workerLoop();
+    int runJobs(const std::function<void(int, int)>& func, int count, int grain);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    bool stopping;
+
+    // 현재 배치 상태
+    const std::function<void(int, int)>* batchFunc;
+    int batchCount;
+    int batchGrain;
+    unsigned int batchGeneration;
+    std::atomic<int> nextJob;
+    int jobsRemaining;
+    int activeWorkers; // 현재 배치를 처리 중인 워커 수 (배치가 겹치지 않도록)
+};
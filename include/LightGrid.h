@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Chunk.h"
+
+class Map;
+
+// 점광원(횃불, 빛나는 아이템, 몬스터 눈 등)을 타일 단위로 누적한 조명 격자.
+// 광원마다 반경 안의 타일에 벽 차폐를 반영한 밝기를 한 번 뿌려(splat) 두고, 광원이 바뀌거나
+// 그 범위의 청크 리비전이 바뀔 때만 다시 계산한다. 렌더러는 픽셀마다 광원을 평가하지 않고 격자만 읽는다.
+class LightGrid {
+public:
+    static constexpr float MAX_LIGHT_RADIUS = 12.0f;
+
+    LightGrid();
+
+    // 광원 등록/수정. 반환된 ID는 removeLight 전까지 유효
+    int addLight(float x, float y, float radius, float intensity);
+    void removeLight(int id);
+    void moveLight(int id, float x, float y);
+    void setLightIntensity(int id, float intensity);
+
+    // 바뀐 광원만 다시 뿌리고, 하나라도 바뀌었으면 청크별 격자를 다시 합친다. 다시 합쳤으면 true
+    bool update(const Map* map);
+
+    // 타일의 누적 밝기 (광원이 닿지 않으면 0)
+    float sample(int tileX, int tileY) const;
+    // 청크의 타일별 밝기 (CHUNK_SIZE * CHUNK_SIZE, 행 우선). 빛이 없으면 nullptr
+    const float* findChunkLight(int chunkX, int chunkY) const;
+
+    bool isEmpty() const { return chunkLights.empty(); }
+    // 빛이 닿은 타일을 감싸는 사각형 (isEmpty면 의미 없음)
+    void getLitBounds(int& minX, int& minY, int& maxX, int& maxY) const;
+
+    int getLightCount() const { return activeLights; }
+    size_t getLitChunkCount() const { return chunkLights.size(); }
+
+private:
+    struct Light {
+        float x, y, radius, intensity;
+        bool active;
+        bool dirty;
+        uint32_t revision;          // 범위를 덮는 청크 리비전의 해시
+        int originX, originY, size; // 뿌린 영역 (타일)
+        std::vector<float> splat;   // size * size
+    };
+
+    struct ChunkLight {
+        float levels[CHUNK_SIZE * CHUNK_SIZE];
+    };
+
+    uint32_t footprintRevision(const Map* map, const Light& light) const;
+    void splatLight(const Map* map, Light& light);
+    void accumulate();
+    // 광원에서 타일 중앙까지 사이에 벽이 있는지 (목표 타일 자체는 제외)
+    static bool isVisible(const Map* map, float fromX, float fromY, int tileX, int tileY);
+
+    std::vector<Light> lights;
+    std::vector<int> freeIds;
+    int activeLights;
+    bool removedSinceUpdate;
+
+    std::unordered_map<uint64_t, ChunkLight> chunkLights;
+    int litMinX, litMinY, litMaxX, litMaxY;
+};
+
+// 같은 청크를 연달아 읽을 때 해시 조회를 건너뛰는 읽기 도우미. 렌더 작업마다 하나씩 만든다
+class LightGridSampler {
+public:
+    explicit LightGridSampler(const LightGrid& grid)
+        : grid(grid), lastChunkX(0), lastChunkY(0), lastLevels(nullptr), hasLast(false) {}
+
+    float sample(int tileX, int tileY) {
+        int chunkX = tileX >> CHUNK_SHIFT;
+        int chunkY = tileY >> CHUNK_SHIFT;
+        if (!hasLast || chunkX != lastChunkX || chunkY != lastChunkY) {
+            lastChunkX = chunkX;
+            lastChunkY = chunkY;
+            lastLevels = grid.findChunkLight(chunkX, chunkY);
+            hasLast = true;
+        }
+        return lastLevels ? lastLevels[(tileY & CHUNK_MASK) * CHUNK_SIZE + (tileX & CHUNK_MASK)] : 0.0f;
+    }
+
+private:
+    const LightGrid& grid;
+    int lastChunkX, lastChunkY;
+    const float* lastLevels;
+    bool hasLast;
+};
@@ -1,6 +1,9 @@
 #pragma once
 #include <cmath>
 #include <vector>
+#include "LightGrid.h"
+
+class Map;
 
 class LightSystem {
 private:
@@ -14,7 +17,19 @@ private:
     std::vector<float> distanceLightingLUT;
     int lutSize;
 
+    // 손전등 원뿔 LUT: [각도 오프셋 단계][거리 단계]에 사거리 안쪽의 손전등 밝기 (강도 * 원뿔 * 거리 감쇠).
+    // 각도는 0 ~ 원뿔각, 거리는 0 ~ 사거리를 균등하게 나눈다. 사거리 밖은 거리 0 값에서 바로 계산한다
+    static constexpr int CONE_ANGLE_STEPS = 128;
+    static constexpr int CONE_DISTANCE_STEPS = 256;
+    std::vector<float> coneLightingLUT;
+
+    // 점광원 (횃불, 빛나는 아이템 등)을 타일별로 누적한 격자
+    LightGrid pointLights;
+
     void initializeDistanceLUT();
+    void initializeConeLUT();
+    // 강도/사거리/원뿔각이 바뀌면 두 LUT를 다시 만든다
+    void rebuildLUTs();
     
 public:
     LightSystem();
@@ -24,6 +39,7 @@ public:
     void toggleFlashlight();
     void setFlashlightIntensity(float intensity);
     void setFlashlightRange(float range);
+    void setFlashlightConeAngle(float angle);
     void setAmbientLight(float ambient);
     
     // 조명 계산
@@ -38,9 +54,24 @@ public:
 
     // 룩업 테이블에서 조명 값 가져오기
     float getLightFromDistanceLUT(float distance) const;
+
+    // 벽 조명: calculateLighting과 같은 값을 원뿔 LUT에서 쌍선형 보간으로 가져온다.
+    // angleOffset은 시선과 광선의 각도 차이 (화면 열마다 고정), distance는 보정된 거리
+    float getConeLight(float angleOffset, float distance) const;
+
+    // 점광원. 등록/이동해도 바로 반영되지 않고 updatePointLights에서 바뀐 광원만 다시 계산한다
+    int addPointLight(float x, float y, float radius, float intensity);
+    void removePointLight(int id);
+    void movePointLight(int id, float x, float y);
+    void setPointLightIntensity(int id, float intensity);
+    // 프레임마다 렌더 전에 한 번 호출 (청크 로드/벽 변경도 여기서 감지)
+    void updatePointLights(const Map* map);
+    const LightGrid& getPointLightGrid() const { return pointLights; }
     
     // Getter 함수들
     bool isFlashlightEnabled() const { return flashlightEnabled; }
     float getFlashlightIntensity() const { return flashlightIntensity; }
     float getAmbientLight() const { return ambientLight; }
+    float getFlashlightRange() const { return flashlightRange; }
+    float getFlashlightConeAngle() const { return flashlightConeAngle; }
 };
@@ -1,30 +1,108 @@
 #pragma once
+#include <deque>
 #include <vector>
 #include <string>
-#include <map>
 #include <utility>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "Chunk.h"
+#include "ChunkTable.h"
 #include "ItemManager.h"
 
 class MapGenerator; // Forward declaration
+class ChunkStreamer;
+class RegionStore;
+class JobSystem;
+
+// 청크 상주/제거 통계
+struct ChunkStats {
+    int resident;                      // 현재 메모리에 있는 청크 수
+    int pending;                       // 생성 요청 후 대기 중인 청크 수
+    long long evicted;                 // 지금까지 제거된 청크 수
+    long long regenerated;             // 최근 제거된 청크 (상주 예산만큼 기억) 중 다시 로드(생성 또는 저장소)된 수
+    long long loadedFromStore;         // 저장소에서 읽어 온 청크 수
+    long long written;                 // 저장소에 기록된 청크 수
+    long long regenerationMismatches;  // 다시 생성했는데 내용이 달랐던 청크 수 (JOOM_VERIFY_CHUNKS 빌드에서만 검사, 항상 0이어야 함)
+};
 
 class Map {
 public:
     Map();
+    explicit Map(unsigned int seed);
     ~Map();
 
     void generateInitialChunk();
-    void checkAndLoadChunks(float playerX, float playerY);
+    // 완성된 청크를 맵에 반영하고, 플레이어 주변의 빈 청크를 백그라운드 생성 요청한다.
+    // 생성 중인 청크는 로드되기 전까지 벽으로 취급된다.
+    void checkAndLoadChunks(float playerX, float playerY, float playerAngle);
+    // 호출 스레드에서 즉시 로드 (저장본이 있으면 그것을, 없으면 생성). 시작 지점, 도구용
+    void generateChunkNow(int chunkX, int chunkY);
+
+    // directory 아래 리전 파일에 청크를 저장한다. 제거되는 청크와 종료 시 남은 청크가 기록되고,
+    // 이후에는 생성 대신 저장본을 읽는다
+    bool enablePersistence(const std::string& directory);
+    unsigned int getSeed() const { return seed; }
+
+    // [minChunkX, maxChunkX] x [minChunkY, maxChunkY] 범위를 리전 단위로 병렬 생성해 저장소에 바로 기록한다.
+    // 이미 저장된 청크는 건너뛴다. 로드된 청크에는 영향이 없다. 기록한 청크 수를 반환 (저장소가 없으면 -1)
+    long long pregenerate(int minChunkX, int minChunkY, int maxChunkX, int maxChunkY, JobSystem& jobs);
 
     bool isWallAt(float x, float y) const;
     int getWallType(int x, int y) const;
+    // 로드된 청크의 타일을 바꾼다 (저장 대상이 됨). 청크가 없으면 false
+    bool setWallType(int x, int y, int wallType);
     
     // These methods will need to be adapted or re-thought for an infinite map
     int getWidth() const;
     int getHeight() const;
 
+    // 청크 좌표로 로드된 청크를 찾는다 (없으면 nullptr)
+    const Chunk* findChunk(int chunkX, int chunkY) const;
+    // 청크가 로드되거나 타일이 바뀔 때마다 달라지는 값 (로드되지 않은 청크는 0). 경로 탐색 캐시 무효화용
+    uint32_t getChunkRevision(int chunkX, int chunkY) const { return chunks.getRevision(chunkX, chunkY); }
+
+    // 상주 예산: 플레이어 청크에서 evictRadius(체비셰프 거리)보다 먼 청크는 바로 제거하고,
+    // 그래도 maxResidentChunks를 넘으면 가장 오래 플레이어 주변에 없었던 청크부터 제거한다.
+    // 제거된 청크는 다시 가까워지면 시드로부터 같은 내용으로 재생성된다.
+    static const int DEFAULT_EVICT_RADIUS = 16;
+    void setResidencyBudget(int maxResidentChunks, int evictRadius = DEFAULT_EVICT_RADIUS);
+    void setResidencyBudgetBytes(size_t maxBytes, int evictRadius = DEFAULT_EVICT_RADIUS);
+    ChunkStats getChunkStats() const;
+
 private:
-    std::map<std::pair<int, int>, Chunk> chunks;
+    Chunk& addChunk(int chunkX, int chunkY);
+    void removeChunk(int chunkX, int chunkY);
+    void onChunkLoaded(int chunkX, int chunkY, const Chunk& chunk, bool fromStore);
+    void evictChunks(int playerChunkX, int playerChunkY);
+    void rememberEvicted(uint64_t key, const Chunk& chunk);
+    static uint32_t checksumChunk(const Chunk& chunk);
+
+    ChunkTable chunks;
+    unsigned int seed;
     std::unique_ptr<MapGenerator> mapGenerator;
+    std::unique_ptr<RegionStore> regionStore; // chunkStreamer보다 먼저 선언 (워커가 사용하므로 나중에 소멸)
+    std::unique_ptr<ChunkStreamer> chunkStreamer;
+    std::unordered_set<uint64_t> unsavedChunks; // 저장소에 없는 내용을 가진 청크 (생성 또는 수정됨)
+    std::unordered_set<uint64_t> pendingChunks; // 요청했지만 아직 도착하지 않은 청크
+
+    // 상주 정책
+    int maxResidentChunks;
+    int evictRadius;
+    uint32_t residencyTick;                // checkAndLoadChunks 호출마다 증가 (LRU 기준)
+    int lastPlayerChunkX, lastPlayerChunkY;
+    bool chunksAdded;                      // 마지막 제거 검사 이후 청크가 추가되었는지
+    // 최근 maxResidentChunks번 제거된 청크. 다시 로드되면 regenerated로 세고 지운다
+    struct EvictedChunk {
+        uint32_t order;    // evictionOrder에 넣을 때의 번호 (같은 청크가 다시 제거되면 새 번호)
+        uint32_t checksum; // JOOM_VERIFY_CHUNKS 빌드에서만 채운다
+    };
+    std::unordered_map<uint64_t, EvictedChunk> recentlyEvicted;
+    std::deque<std::pair<uint64_t, uint32_t>> evictionOrder; // (key, order), 오래된 것부터
+    uint32_t evictionCounter;
+    ChunkStats stats;
+
+    // 청크 구성이 바뀔 때마다 새 값을 받는다. 스레드별 마지막 청크 캐시는 이 값이 같을 때만 유효
+    unsigned int generation;
+    uint32_t lastRevision; // 청크 리비전 발급용
 };
@@ -1,16 +1,33 @@
 #pragma once
 
 #include "Chunk.h"
+#include "PerlinBatch.h"
 #include "PerlinNoise.hpp"
 
+class JobSystem;
+
 class MapGenerator {
 public:
     MapGenerator(unsigned int seed);
 
-    Chunk generateChunk(int chunkX, int chunkY);
+    // 결과를 임시 객체 없이 chunk에 바로 채운다
+    // 여러 스레드에서 동시에 호출해도 안전하다 (노이즈 테이블은 읽기 전용)
+    void generateChunk(int chunkX, int chunkY, Chunk& chunk) const;
+
+    // 직사각형 범위를 jobs의 모든 스레드로 나눠 생성. out[y * width + x]는 청크 (firstChunkX + x, firstChunkY + y)
+    void generateChunks(int firstChunkX, int firstChunkY, int width, int height, Chunk* out, JobSystem& jobs) const;
+
+    // 타일마다 octave2D_01을 호출하는 예전 방식 (벤치마크, 결과 비교용)
+    void generateChunkReference(int chunkX, int chunkY, Chunk& chunk) const;
+
+    const siv::PerlinNoise& getNoise() const { return perlin; }
+    double getFrequency() const { return frequency; }
+    int getOctaves() const { return octaves; }
 
 private:
     siv::PerlinNoise perlin;
+    PerlinBatch perlinBatch;
     double frequency = 0.05; // Controls the "zoom" level of the noise
     double threshold = 0.5;  // Determines wall vs. floor
+    int octaves = 4;
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+class Map;
+class FlowField;
+class SpatialGrid;
+
+enum class MonsterState : uint8_t {
+    IDLE,      // 주변을 배회
+    CHASING,   // 플레이어 추격
+    ATTACKING  // 플레이어 바로 옆 (정지)
+};
+
+// 모든 몬스터를 구조체 배열(SoA)로 보관하고 한 번의 update로 일괄 갱신한다.
+// 에이전트 i의 상태는 각 배열의 i번째 원소이며, 제거는 마지막 원소와 맞바꾼다 (인덱스는 프레임 사이에 바뀔 수 있음).
+// - 가까운 몬스터는 매 프레임, 먼 몬스터는 거리 단계에 따라 몇 프레임에 한 번만 생각하고 움직인다 (LOD).
+//   건너뛴 시간은 쌓아 두었다가 다음 차례에 한꺼번에 적용하므로 평균 속도는 같다.
+// - 추격은 공유 FlowField를 따른다. 추격 반경이 거리 지도 창보다 훨씬 작으므로 개별 경로 탐색은 하지 않고,
+//   거리 지도에 방향이 없으면 (플레이어와 같은 타일이거나 도달 불가) 플레이어를 직접 향한다.
+class MonsterSystem {
+public:
+    static constexpr float CHASE_RADIUS = 10.0f;       // 이 거리 안이면 추격 (기존 Monster와 같음)
+    static constexpr float ATTACK_RADIUS = 0.6f;
+    static constexpr float CHASE_SPEED = 1.8f;
+    static constexpr float WANDER_SPEED = 0.6f;
+    // LOD 거리 단계: 화면에 보일 수 있는 거리(렌더러 사거리 20)까지는 매 프레임
+    static constexpr float LOD_FULL_DISTANCE = 24.0f;
+    static constexpr float LOD_MID_DISTANCE = 48.0f;
+    static constexpr int LOD_MID_INTERVAL = 4;         // 프레임 (2의 거듭제곱)
+    static constexpr int LOD_FAR_INTERVAL = 16;
+    // populate가 새로 배치하는 거리와 제거하는 거리
+    static constexpr float SPAWN_MIN_DISTANCE = 16.0f;
+    static constexpr float SPAWN_MAX_DISTANCE = 40.0f;
+    static constexpr float DESPAWN_DISTANCE = 64.0f;
+
+    // grid가 있으면 몬스터를 SPATIAL_LAYER_MONSTER로 등록한다 (userData = 인덱스)
+    explicit MonsterSystem(SpatialGrid* grid, unsigned int seed = 1);
+    ~MonsterSystem();
+
+    int spawn(float x, float y);
+    void despawn(int index);
+    void clear();
+
+    // 플레이어에서 먼 몬스터를 지우고, 로드된 빈 타일에 새로 배치해 targetCount를 유지한다 (프레임당 배치 수 제한)
+    void populate(const Map* map, float playerX, float playerY, int targetCount);
+
+    void update(const Map* map, float playerX, float playerY, float deltaTime);
+
+    // LOD를 끄면 모든 몬스터가 매 프레임 갱신된다 (비교용)
+    void setLevelOfDetail(bool enabled) { levelOfDetail = enabled; }
+    bool isLevelOfDetail() const { return levelOfDetail; }
+
+    int getCount() const { return static_cast<int>(posX.size()); }
+    float getX(int index) const { return posX[index]; }
+    float getY(int index) const { return posY[index]; }
+    // 직전 update 시작 시점의 위치 (고정 스텝 사이의 화면 프레임 보간용).
+    // 그 update에서 움직이지 않은 몬스터는 현재 위치와 같다
+    float getPreviousX(int index) const { return tickFrame[index] == frame ? prevX[index] : posX[index]; }
+    float getPreviousY(int index) const { return tickFrame[index] == frame ? prevY[index] : posY[index]; }
+    MonsterState getState(int index) const { return state[index]; }
+    float getNearestDistance() const { return nearestDistance; }
+
+    // 마지막 update에서 생각/이동한 몬스터 수
+    int getLastTickCount() const { return lastTickCount; }
+    const FlowField* getFlowField() const { return flowField.get(); }
+
+private:
+    void think(int index, float playerX, float playerY, float deltaTime);
+    void integrate(int index, const Map* map, float deltaTime);
+
+    // 구조체 배열
+    std::vector<float> posX, posY;
+    std::vector<float> prevX, prevY;    // 마지막으로 움직이기 직전의 위치
+    std::vector<uint32_t> tickFrame;    // 마지막으로 움직인 update의 frame (prevX/prevY가 유효한 프레임)
+    std::vector<float> velX, velY;
+    std::vector<MonsterState> state;
+    std::vector<float> distanceSquared; // 이번 update의 플레이어까지 거리 제곱
+    std::vector<float> pendingTime;     // LOD로 건너뛰며 쌓인 시간
+    std::vector<float> wanderTimer;     // 다음 배회 방향 변경까지 남은 시간
+    std::vector<int> spatialHandle;
+
+    SpatialGrid* grid;
+    std::unique_ptr<FlowField> flowField;
+    std::mt19937 rng;
+    uint32_t frame;
+    bool levelOfDetail;
+    float nearestDistance;
+    int lastTickCount;
+};
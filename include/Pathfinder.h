@@ -1,43 +1,83 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <cmath>
-#include <queue>
-#include <map>
-#include <algorithm>
+#include "IndexedHeap.h"
 
 // 맵 클래스 전방 선언
 class Map;
+class ChunkGraph;
 
-// A* 알고리즘에 사용될 노드 구조체
-struct Node {
+// 경로 위의 한 타일
+struct PathPoint {
     int x, y;
-    float gCost; // 시작점으로부터의 비용
-    float hCost; // 목적지까지의 예상 비용 (Heuristic)
-    float fCost; // gCost + hCost
-    Node* parent;
-
-    Node(int x, int y, Node* parent = nullptr)
-        : x(x), y(y), gCost(0), hCost(0), fCost(0), parent(parent) {}
-
-    // fCost를 기준으로 노드를 비교하기 위한 연산자
-    bool operator>(const Node& other) const {
-        return fCost > other.fCost;
-    }
+};
+
+// 탐색 창 안에서 쓰는 탐색 방식. 둘 다 같은 비용의 최단 경로를 찾는다
+enum class PathStrategy {
+    AStar,     // 8방향 이웃을 모두 여는 기본 A*
+    JumpPoint  // Jump Point Search: 직선/대각선으로 건너뛰며 갈림길(점프 지점)만 열린 목록에 넣는다
 };
 
 class Pathfinder {
 public:
+    // 시작점과 목적지를 감싸는 탐색 창의 여유 칸 수와 최대 한 변 길이 (무한 맵에서 탐색 범위 제한)
+    static const int SEARCH_MARGIN = 16;
+    static const int MAX_SEARCH_WINDOW = 128;
+    // 두 점이 이 거리(체비셰프)보다 멀면 청크 그래프로 계층 탐색한다
+    static const int HIERARCHICAL_DISTANCE = 24;
+
     Pathfinder();
     ~Pathfinder();
 
-    // A* 알고리즘을 사용하여 경로를 찾는 메인 함수
-    std::vector<Node*> findPath(int startX, int startY, int endX, int endY, Map* map);
+    // 경로를 찾아 path에 시작점부터 목적지까지 기록한다 (8방향, 대각선은 양 옆이 막히면 불가).
+    // 가까운 목적지는 탐색 창 안에서 최단 경로를 (A* 또는 JPS), 먼 목적지는 청크 진입점 그래프(HPA*)를 탐색한 뒤
+    // 구간마다 청크 안에서 다시 찾아 이어 붙인다 (최단에 가까운 경로). 로드된 청크 밖으로는 가지 않는다.
+    // 작업 메모리는 호출 간에 재사용되어 평상시에는 할당하지 않는다.
+    bool findPath(int startX, int startY, int endX, int endY, const Map* map, std::vector<PathPoint>& path);
+
+    void setStrategy(PathStrategy newStrategy) { strategy = newStrategy; }
+    PathStrategy getStrategy() const { return strategy; }
+    // 마지막 findPath에서 열린 목록에서 꺼낸 노드 수 (벤치마크용)
+    int getLastExpansions() const { return lastExpansions; }
+
+    // 목적지까지의 휴리스틱 비용 계산 (옥타일 거리)
+    static float calculateHeuristic(int x1, int y1, int x2, int y2);
 
 private:
-    // 목적지까지의 휴리스틱 비용 계산 (유클리드 거리)
-    float calculateHeuristic(int x1, int y1, int x2, int y2);
+    // [minX, maxX] x [minY, maxY] 창 안에서만 탐색. path 뒤에 이어 붙인다 (includeStart가 false면 시작점 제외)
+    bool findPathInWindow(int startX, int startY, int endX, int endY, int minX, int minY, int maxX, int maxY,
+                          const Map* map, std::vector<PathPoint>& path, bool includeStart);
+
+    // 창 안의 칸 하나를 열거나 더 짧은 비용으로 갱신
+    void relaxCell(int current, int neighbor, float cost, int neighborX, int neighborY, int endX, int endY);
+    void expandAStar(int current, int endX, int endY, const Map* map);
+    void expandJumpPoint(int current, int endX, int endY);
+    // (x, y)에서 (dx, dy) 방향으로 나아가 다음 점프 지점을 찾는다. 막히거나 창을 벗어나면 false
+    bool jump(int x, int y, int dx, int dy, int endX, int endY, int& jumpX, int& jumpY) const;
+    bool isWalkable(int x, int y) const;
+    // 탐색 창의 벽 여부를 청크 행 단위로 복사해 둔다 (JPS는 한 번의 점프에 많은 칸을 확인하므로)
+    void loadWindowTiles(const Map* map);
+
+    // 탐색 창 크기에 맞게 작업 메모리를 확보하고 새 세대를 시작
+    void prepareScratch(int cellCount);
+
+    PathStrategy strategy;
+    int lastExpansions;
+
+    std::unique_ptr<ChunkGraph> chunkGraph;
+    std::vector<PathPoint> waypoints;
+
+    // 탐색 창 (월드 타일 좌표)
+    int originX, originY, windowWidth, windowHeight;
 
-    // 경로를 역추적하여 생성하는 함수
-    std::vector<Node*> reconstructPath(Node* endNode);
+    // 칸별 작업 메모리: stamp가 현재 세대와 같을 때만 gCost/parent가 유효
+    std::vector<float> gCost;
+    std::vector<int> parent;
+    std::vector<uint32_t> stamp;
+    std::vector<uint8_t> closed;
+    std::vector<uint8_t> blocked; // loadWindowTiles가 채운 창의 벽 여부 (JPS 전용)
+    uint32_t generation;
+    IndexedHeap openSet;
 };
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include "PerlinNoise.hpp"
+
+// siv::PerlinNoise와 같은 순열 테이블로 격자 전체를 한 번에 계산하는 배치 평가기.
+// 결과는 perlin.octave2D_01((originX + col) * frequency, (originY + row) * frequency, octaves, persistence)와
+// float 오차 범위 안에서 같다.
+//
+// - 2D 노이즈는 z가 상수인 3D 노이즈이므로 격자점마다 z 방향 두 기울기를 미리 합쳐 (gx, gy, c) 하나로 줄인다.
+// - 격자 행(iy)이 바뀔 때만 순열을 조회하고, 인접 격자 행은 이전 결과를 재사용한다.
+// - 한 행 안에서는 열 단위 배열에 대해 SIMD(SSE2, 4개씩)로 계산한다.
+class PerlinBatch {
+public:
+    static constexpr int MAX_WIDTH = 64;
+    static constexpr int MAX_OCTAVES = 16;
+
+    explicit PerlinBatch(const siv::PerlinNoise::state_type& permutation);
+
+    // out[row * width + col]에 기록. width <= MAX_WIDTH, octaves <= MAX_OCTAVES, frequency > 0
+    void octave2D_01(int originX, int originY, double frequency, int width, int height,
+                     int octaves, float persistence, float* out) const;
+
+private:
+    struct Corner {
+        float gx, gy, c; // 노이즈 기여 = gx * dx + gy * dy + c
+    };
+
+    Corner makeCorner(int cellX, int cellY) const;
+
+    uint8_t perm[256];
+    float fadeZ;  // 상수 z의 Fade 값
+    float lowerZ; // z 아래 평면까지의 거리 (fz)
+    float upperZ; // z 위 평면까지의 거리 (fz - 1)
+};
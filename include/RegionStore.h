@@ -0,0 +1,95 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Chunk.h"
+
+// 리전 파일: 32x32 청크를 파일 하나에 저장한다.
+// [RegionHeader][청크 슬롯 1024개] 고정 배치이고, 헤더의 offsets[i]가 0이 아니면 i번 청크가 저장되어 있다.
+// 파일명은 r.<regionX>.<regionY>.bin (리전 좌표 = 청크 좌표 >> REGION_SHIFT)
+const int REGION_SHIFT = 5;
+const int REGION_SIZE = 1 << REGION_SHIFT;
+const int REGION_CHUNKS = REGION_SIZE * REGION_SIZE;
+const uint32_t REGION_VERSION = 1;
+
+struct RegionHeader {
+    char magic[4];          // "JMRG"
+    uint32_t version;
+    int32_t regionX, regionY;
+    uint32_t chunkBytes;    // sizeof(Chunk), 형식이 바뀌었는지 확인용
+    uint32_t offsets[REGION_CHUNKS];
+};
+
+// 청크 영구 저장소.
+// 읽기는 리전 파일을 메모리 매핑해 슬롯을 바로 복사하고 (Windows에서는 파일 읽기로 대체),
+// 쓰기는 큐에 모았다가 전용 스레드가 리전별로 묶어서 기록한다.
+class RegionStore {
+public:
+    explicit RegionStore(const std::string& directory);
+    ~RegionStore(); // 남은 쓰기를 모두 기록한 뒤 종료
+
+    RegionStore(const RegionStore&) = delete;
+    RegionStore& operator=(const RegionStore&) = delete;
+
+    bool isOpen() const { return open; }
+
+    // 저장된 청크가 있으면 chunk에 복사하고 true. 아직 기록되지 않은 쓰기도 반영된다 (스레드 안전)
+    bool readChunk(int chunkX, int chunkY, Chunk& chunk);
+    // 쓰기 예약. 같은 청크를 여러 번 예약하면 마지막 내용이 남는다
+    void queueWrite(int chunkX, int chunkY, const Chunk& chunk);
+    // 예약된 쓰기가 모두 기록될 때까지 대기
+    void flush();
+
+    // 리전 하나를 호출 스레드에서 바로 기록 (대량 생성용). chunks[i]는 리전 안 i번 슬롯
+    // (i = 리전 내 y * REGION_SIZE + x), nullptr인 슬롯은 기존 내용을 유지한다
+    bool writeRegion(int regionX, int regionY, const Chunk* const* chunks);
+
+    long long getChunksWritten() const;
+
+private:
+    struct PendingWrite {
+        int chunkX, chunkY;
+        Chunk chunk;
+    };
+
+    struct Region {
+        const unsigned char* data; // 매핑된 파일 전체 (없으면 nullptr)
+        size_t size;
+        int fd;
+    };
+
+    void writerLoop();
+    void writeBatch(const std::vector<PendingWrite>& batch);
+    bool writeRegionLocked(int regionX, int regionY, const Chunk* const* chunks);
+    std::string regionPath(int regionX, int regionY) const;
+    Region* openRegion(int regionX, int regionY, bool create);
+    void closeRegions();
+
+    static bool findPending(const std::vector<PendingWrite>& writes, int chunkX, int chunkY, Chunk& chunk);
+
+    std::string directory;
+    bool open;
+
+    // 쓰기 큐: queued는 아직 가져가지 않은 것, writing은 기록 중인 묶음
+    mutable std::mutex queueMutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable flushedCondition;
+    std::vector<PendingWrite> queued;
+    std::vector<PendingWrite> writing;
+    bool stopping;
+    int flushRequests;  // flush()로 대기 중인 호출 수 (묶음이 덜 찼어도 바로 기록)
+    long long chunksWritten;
+
+    // 리전 파일 (매핑, 파일 입출력)
+    std::mutex regionMutex;
+    std::map<std::pair<int, int>, Region> regions;
+    std::set<std::pair<int, int>> missingRegions; // 파일이 없는 것으로 확인된 리전
+
+    std::thread writer;
+};
@@ -5,8 +5,33 @@
 #include "TextureManager.h"
 #include "LightSystem.h"
 #include "ItemManager.h"
+#include "JobSystem.h"
+#include "FloorSpan.h"
+#include "FrameSnapshot.h"
+#include <memory>
 
-class Monster;
+// 벽 레이캐스팅 방식 (A/B 비교용)
+enum class WallCaster {
+    DDA,        // 타일 경계를 정확히 한 번씩 방문하는 그리드 탐색
+    RayMarch    // 0.05 단위 고정 스텝 전진 (이전 방식)
+};
+
+// 벽/바닥/천장/스프라이트 조명 계산 방식
+enum class LightingMode {
+    Float,      // 채널마다 float 곱셈 후 절삭 (바닥/천장은 스칼라 커널)
+    FixedPoint  // 8.8 고정소수점 밝기: 벽/스프라이트는 셰이드 테이블 조회, 바닥/천장은 SIMD span 커널
+};
+// Renderer 생성 시와 GameOptions의 기본값
+constexpr LightingMode DEFAULT_LIGHTING_MODE = LightingMode::FixedPoint;
+
+// 레이가 벽에 맞은 지점 정보
+struct WallHit {
+    int wallType;   // 0이면 맞지 않음
+    float distance; // 레이 방향 거리 (보정 전)
+    float hitX, hitY;
+    float wallX;    // 벽면 내 텍스처 좌표 (0.0 ~ 1.0)
+    int side;       // 0: X면 (세로 격자선), 1: Y면 (가로 격자선)
+};
 
 class Renderer {
 public:
@@ -14,30 +39,108 @@ public:
     ~Renderer();
 
     void initializeTextures();
-    void render(Player* player, Map* map, const std::vector<Item>& items, const Monster* monster);
+    // 스프라이트는 직전/현재 시뮬레이션 스텝 위치 사이 interpolation(0~1) 지점에 그린다.
+    // 시뮬레이션 상태는 읽지 않으므로 다른 스레드가 다음 프레임을 시뮬레이션하는 동안 호출해도 된다 (맵은 읽기만 함)
+    void render(Player* player, Map* map, const std::vector<SpriteState>& sprites, float interpolation = 1.0f);
     void present();
     void renderMiniMap(Player* player, Map* map); // 미니맵은 버퍼링 없이 직접 렌더링
 
+    void setWallCaster(WallCaster caster) { wallCaster = caster; }
+    WallCaster getWallCaster() const { return wallCaster; }
+
+    // 렌더링 스레드 수 (0 이하: CPU 코어 수, 1: 메인 스레드만 사용)
+    void setThreadCount(int threadCount);
+    int getThreadCount() const { return jobSystem->getThreadCount(); }
+
+    // 바닥/천장 span 커널 선택. 지원되지 않거나 기준 구현과 결과가 다르면 다른 커널로 대체된다
+    void setSpanKernel(SpanKernel kernel);
+    SpanKernel getSpanKernel() const { return spanKernel; }
+
+    // 고정소수점 모드는 설정 시 float 경로와 비교해 오차 한도를 넘으면 float로 되돌린다 (바닥은 현재 span 커널로 검사하므로 setSpanKernel 다음에 호출)
+    void setLightingMode(LightingMode mode);
+    LightingMode getLightingMode() const { return lightingMode; }
+
+    // 고정소수점 경로(벽 셰이드 테이블, 바닥 span 커널)와 applyLighting의 채널별 최대 오차
+    int measureFixedLightingError() const;
+
+    // 거리에 따라 밉맵 단계를 고를지 여부 (끄면 항상 원본 해상도)
+    void setMipmapping(bool enabled) { mipmapping = enabled; }
+    bool isMipmapping() const { return mipmapping; }
+
 private:
-    void renderFloorAndCeiling(Player* player, Uint32* pixels);
-    void renderWalls(Player* player, Map* map, Uint32* pixels);
-    void renderSprites(Player* player, const std::vector<Item>& items, const Monster* monster, Uint32* pixels);
+    // 바닥/천장은 화면 아래 절반의 행 구간 [rowBegin, rowEnd) 단위, 벽은 열 구간 [columnBegin, columnEnd) 단위로 그린다
+    void renderFloorAndCeiling(Player* player, Uint32* pixels, int rowBegin, int rowEnd);
+    void renderWalls(Player* player, Map* map, Uint32* pixels, int columnBegin, int columnEnd);
+    // 스프라이트는 한 번 카메라 공간으로 옮겨 컬링/정렬한 뒤 (prepareSprites), 벽과 같은 열 구간 단위로 그린다
+    void prepareSprites(Player* player, const std::vector<SpriteState>& sprites, float interpolation);
+    void renderSprites(Uint32* pixels, int columnBegin, int columnEnd);
+
+    bool castRayDDA(const Map* map, float originX, float originY, float dirX, float dirY, WallHit& hit) const;
+    bool castRayMarch(const Map* map, float originX, float originY, float dirX, float dirY, WallHit& hit) const;
 
     Uint32 applyLighting(Uint32 color, float lighting) const;
+    void buildShadeTable();
 
     SDL_Renderer* renderer;
     SDL_Texture* screenBuffer;
     int screenWidth, screenHeight;
     TextureManager* textureManager;
     LightSystem* lightSystem;
+
+    // initializeTextures()에서 한 번 해석한 텍스처 핸들
+    TextureHandle floorTexture;
+    TextureHandle ceilingTexture;
+    TextureHandle wallTextures[3]; // 벽 타입 1(벽돌), 2(돌), 3(금속)
+    TextureHandle itemTextures[6]; // ItemType 1 ~ 6
+    TextureHandle monsterTexture;
     std::vector<float> depthBuffer;
+    // 바닥 작업(FLOOR_ROWS_PER_JOB 행 띠)마다 한 행 분량의 픽셀별 밝기 단계. 띠끼리 겹치지 않아 스레드 간 공유 없음
+    std::vector<uint16_t> floorLightLevels;
+    std::vector<float> floorPixelLighting; // 같은 배치, float 조명 모드용
+    // 화면 열마다 고정된 시선 기준 광선 각도 오프셋과 그 cos/sin (FOV와 화면 폭으로 한 번 계산)
+    std::vector<float> columnAngleOffsets;
+    std::vector<float> columnCos;
+    std::vector<float> columnSin;
+    std::vector<float> columnTan;
+
+    // 이번 프레임에 그릴 스프라이트 (화면 안, 사거리 안). 먼 것부터 정렬되어 있다
+    struct SpriteInstance {
+        float depth;          // 시선 방향 거리 (depthBuffer와 같은 기준)
+        float lateral;        // 시선에 수직인 방향 오프셋 (오른쪽이 +)
+        float invWidth;       // 1 / 월드 폭
+        float top;            // 화면상 윗변 (소수 포함)
+        float height;         // 화면상 높이 (픽셀)
+        int columnStart, columnEnd; // 덮는 화면 열 [start, end)
+        TextureHandle texture;
+        int mipLevel;
+        float lighting;
+    };
+    std::vector<SpriteInstance> visibleSprites;
+    WallCaster wallCaster;
+    std::unique_ptr<JobSystem> jobSystem;
+    SpanKernel spanKernel;
+    FloorSpanFunc floorSpanKernel;
+    LightingMode lightingMode;
+    bool mipmapping;
+
+    // 컬러맵 방식 셰이드 테이블: 밝기 단계(0~256)마다 256개 채널값
+    std::vector<Uint8> shadeTable;
 
     // Profiling
     Uint32 profilingTimer;
     Uint32 wallTimeAccumulator;
     Uint32 floorTimeAccumulator;
+    Uint32 spriteTimeAccumulator;
     int frameCounterForProfile;
 
     static constexpr float FOV = 60.0f;
+    static constexpr float MAX_RAY_DISTANCE = 20.0f;
+    static constexpr float MIN_SPRITE_DEPTH = 0.2f;
+    static constexpr float ITEM_SPRITE_SCALE = 0.4f;
+    static constexpr float MONSTER_SPRITE_SCALE = 0.9f;
+    static constexpr int WALL_COLUMNS_PER_JOB = 16;
+    static constexpr int FLOOR_ROWS_PER_JOB = 8;
+    static constexpr int LIGHT_LEVELS = 257;
+    static constexpr int MAX_FIXED_LIGHTING_ERROR = 1;
     float degreesToRadians(float degrees);
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 엔티티 종류 (비트 마스크로 질의를 거른다)
+enum SpatialLayer : uint32_t {
+    SPATIAL_LAYER_ITEM = 1u << 0,
+    SPATIAL_LAYER_MONSTER = 1u << 1,
+    SPATIAL_LAYER_ALL = 0xFFFFFFFFu
+};
+
+// 아이템과 몬스터가 함께 쓰는 균일 격자 공간 색인.
+// 월드를 CELL_SIZE 타일 정사각형 칸으로 나누고 칸마다 들어 있는 엔티티 핸들을 모아 둔다.
+// 질의 비용은 월드 전체가 아니라 질의 범위 안의 칸 수와 그 안의 엔티티 수에만 비례한다.
+class SpatialGrid {
+public:
+    static constexpr int CELL_SHIFT = 2;
+    static constexpr int CELL_SIZE = 1 << CELL_SHIFT; // 4 타일
+
+    SpatialGrid();
+
+    // 반환된 핸들은 remove 전까지 유효. userData는 호출 측의 인덱스 (예: 아이템 번호)
+    int insert(float x, float y, uint32_t layer, uint32_t userData);
+    void move(int handle, float x, float y);
+    void remove(int handle);
+    void clear();
+
+    // (x, y)에서 radius 안(경계 미포함)에 있는 엔티티 핸들을 results에 채운다 (results는 먼저 비운다)
+    void queryRadius(float x, float y, float radius, uint32_t layerMask, std::vector<int>& results) const;
+    // [minX, maxX] x [minY, maxY] 사각형 안의 엔티티 핸들
+    void queryRect(float minX, float minY, float maxX, float maxY, uint32_t layerMask, std::vector<int>& results) const;
+
+    float getX(int handle) const { return entries[handle].x; }
+    float getY(int handle) const { return entries[handle].y; }
+    uint32_t getLayer(int handle) const { return entries[handle].layer; }
+    uint32_t getUserData(int handle) const { return entries[handle].userData; }
+    // 호출 측 배열에서 원소가 옮겨졌을 때 (예: 맞바꿔 지우기)
+    void setUserData(int handle, uint32_t userData) { entries[handle].userData = userData; }
+    int getCount() const { return activeCount; }
+    size_t getCellCount() const { return cells.size(); } // 한 번이라도 쓰인 칸 수
+
+private:
+    struct Entry {
+        float x, y;
+        uint32_t layer;      // 0이면 빈 슬롯
+        uint32_t userData;
+        uint64_t cellKey;
+        int cellSlot;        // cells[cellKey] 안의 위치 (교체 삭제용)
+    };
+
+    static int cellCoord(float value);
+    void link(int handle);
+    void unlink(int handle);
+
+    std::vector<Entry> entries;
+    std::vector<int> freeHandles;
+    int activeCount;
+    std::unordered_map<uint64_t, std::vector<int>> cells;
+};
@@ -4,6 +4,27 @@
 #include <string>
 #include <vector>
 
+// 텍스처 핸들: 로드 시점에 이름을 한 번 해석해 얻고, 프레임 중에는 핸들로만 접근한다
+using TextureHandle = int;
+const TextureHandle INVALID_TEXTURE_HANDLE = -1;
+
+const int MAX_TEXTURE_MIPS = 12;
+
+// 밉맵 한 단계의 픽셀 정보 (크기는 2의 거듭제곱 기준)
+struct TextureMip {
+    const Uint32* pixels;   // 행 우선 (row-major)
+    const Uint32* columns;  // 열 우선 사본, 없으면 nullptr
+    int width, height;
+    int widthLog2, heightLog2;
+    int widthMask, heightMask;
+};
+
+// 렌더러가 매 프레임 직접 읽는 텍스처 정보. 기본 필드는 원본 해상도(0단계)와 같다
+struct TextureDesc : TextureMip {
+    int mipCount;
+    TextureMip mips[MAX_TEXTURE_MIPS]; // mips[0]은 원본, 이후 단계마다 가로세로 절반 (최소 1)
+};
+
 class TextureManager {
 public:
     TextureManager(SDL_Renderer* renderer, const std::string& textureDir);
@@ -13,23 +34,48 @@ public:
 
     bool loadTexture(const std::string& name, const std::string& filePath);
     SDL_Texture* getTexture(const std::string& name);
-    Uint32 sampleTexture(const std::string& name, float u, float v);
-    const std::vector<Uint32>* getPixels(const std::string& name, int& width, int& height);
+
+    // 이름 -> 핸들 해석 (로드 시점에만 사용)
+    TextureHandle getHandle(const std::string& name) const;
+
+    const TextureDesc* getDesc(TextureHandle handle) const {
+        return (handle >= 0 && handle < static_cast<int>(textureDescs.size())) ? &textureDescs[handle] : nullptr;
+    }
+    Uint32 sampleTexture(TextureHandle handle, float u, float v) const;
+
+    // 벽 텍스처용 열 우선(column-major) 사본. 벽은 세로로 그려지므로 한 열의 텍셀이 연속되도록 저장한다
+    bool buildColumnMajorCopy(TextureHandle handle);
+    const Uint32* getColumn(TextureHandle handle, int texX, int mipLevel = 0) const {
+        const TextureMip& mip = textureDescs[handle].mips[mipLevel];
+        return mip.columns + (texX & mip.widthMask) * mip.height;
+    }
 
     // 절차적 텍스처 생성
     bool createWallTexture(const std::string& name, int width, int height, int type);
     bool createFloorTexture(const std::string& name, int width, int height);
     bool createCeilingTexture(const std::string& name, int width, int height);
+    // 알파가 있는 정사각형 스프라이트. type: 0 열쇠, 1 구급상자, 2 탄약, 3 출구 포털, 4 몬스터 (color는 주 색상)
+    bool createSpriteTexture(const std::string& name, int size, int type, Uint32 color);
 
 private:
     bool cacheTexturePixels(const std::string& name, SDL_Texture* texture);
+    // 픽셀을 이름의 핸들에 저장하고 밉 체인을 만든다 (같은 이름이면 기존 핸들 유지)
+    void storeTexturePixels(const std::string& name, std::vector<Uint32> pixels, int width, int height);
+    void refreshDesc(TextureHandle handle);
 
     SDL_Renderer* renderer;
     std::map<std::string, SDL_Texture*> textures;
     std::string textureDirectory;
 
-    // 픽셀 데이터 캐시
-    std::map<std::string, std::vector<Uint32>> texturePixels;
-    std::map<std::string, int> textureWidths;
-    std::map<std::string, int> textureHeights;
-};
\ No newline at end of file
+    // 픽셀 데이터 캐시: 핸들이 곧 인덱스. 모든 밉 단계를 하나의 벡터에 이어 붙여 저장한다
+    struct TexturePixelData {
+        std::vector<Uint32> pixels;
+        std::vector<Uint32> columns;
+        std::vector<int> mipOffsets;
+        int width, height;
+    };
+    static void buildMipChain(TexturePixelData& data);
+    std::vector<TexturePixelData> texturePixels;
+    std::vector<TextureDesc> textureDescs;
+    std::map<std::string, TextureHandle> textureHandles;
+};
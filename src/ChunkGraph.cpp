@@ -0,0 +1,301 @@
+#include "ChunkGraph.h"
+#include "ChunkTable.h"
+#include "Map.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+const float STRAIGHT_COST = 1.0f;
+const float DIAGONAL_COST = 1.41421356f;
+const float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+const int NEIGHBOR_DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+const int NEIGHBOR_DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+// 한 경계 구간이 이보다 짧으면 가운데 한 곳, 길면 양 끝 두 곳에 진입점을 둔다
+const int LONG_ENTRANCE_RUN = 6;
+
+inline int localIndex(int x, int y) {
+    return (y & CHUNK_MASK) * CHUNK_SIZE + (x & CHUNK_MASK);
+}
+}
+
+ChunkGraph::ChunkGraph() : searchId(0) {
+    localOpen.reserve(CHUNK_SIZE * CHUNK_SIZE);
+}
+
+ChunkGraph::Cluster* ChunkGraph::getCluster(const Map* map, int chunkX, int chunkY) {
+    auto it = clusters.find(ChunkTable::packKey(chunkX, chunkY));
+    if (it != clusters.end() && it->second.searchId == searchId) return &it->second;
+
+    // 이번 탐색에서 처음 만나는 클러스터만 리비전을 확인한다
+    uint32_t revisions[5] = {
+        map->getChunkRevision(chunkX, chunkY),
+        map->getChunkRevision(chunkX - 1, chunkY),
+        map->getChunkRevision(chunkX + 1, chunkY),
+        map->getChunkRevision(chunkX, chunkY - 1),
+        map->getChunkRevision(chunkX, chunkY + 1)
+    };
+    if (revisions[0] == 0) return nullptr;
+
+    Cluster& cluster = it != clusters.end() ? it->second : clusters[ChunkTable::packKey(chunkX, chunkY)];
+    if (!std::equal(revisions, revisions + 5, cluster.revisions)) {
+        std::copy(revisions, revisions + 5, cluster.revisions);
+        buildCluster(map, chunkX, chunkY, cluster);
+    }
+    cluster.searchId = searchId;
+    cluster.searchNodes.assign(cluster.entrances.size(), -1);
+    return &cluster;
+}
+
+void ChunkGraph::buildCluster(const Map* map, int chunkX, int chunkY, Cluster& cluster) {
+    const Chunk& chunk = *map->findChunk(chunkX, chunkY);
+    int baseX = chunkX * CHUNK_SIZE;
+    int baseY = chunkY * CHUNK_SIZE;
+
+    cluster.entrances.clear();
+
+    // 서, 동, 북, 남 경계. k는 경계를 따라가는 로컬 좌표이고, 양쪽 청크가 같은 k로 구간을 나누므로
+    // 이웃 청크에서 계산한 진입점과 정확히 짝이 맞는다.
+    const Chunk* neighbors[4] = {
+        map->findChunk(chunkX - 1, chunkY),
+        map->findChunk(chunkX + 1, chunkY),
+        map->findChunk(chunkX, chunkY - 1),
+        map->findChunk(chunkX, chunkY + 1)
+    };
+    for (int side = 0; side < 4; ++side) {
+        const Chunk* neighbor = neighbors[side];
+        if (!neighbor) continue;
+
+        auto insideTile = [&](int k, int& lx, int& ly) {
+            switch (side) {
+                case 0: lx = 0; ly = k; break;
+                case 1: lx = CHUNK_SIZE - 1; ly = k; break;
+                case 2: lx = k; ly = 0; break;
+                default: lx = k; ly = CHUNK_SIZE - 1; break;
+            }
+        };
+        auto isOpen = [&](int k) {
+            int lx, ly;
+            insideTile(k, lx, ly);
+            // 건너편 타일은 이웃 청크의 반대쪽 가장자리
+            int ox = side == 0 ? CHUNK_SIZE - 1 : side == 1 ? 0 : lx;
+            int oy = side == 2 ? CHUNK_SIZE - 1 : side == 3 ? 0 : ly;
+            return chunk.tiles[ly][lx] == 0 && neighbor->tiles[oy][ox] == 0;
+        };
+        auto addEntrance = [&](int k) {
+            int lx, ly;
+            insideTile(k, lx, ly);
+            int x = baseX + lx;
+            int y = baseY + ly;
+            int partnerX = x + (side == 0 ? -1 : side == 1 ? 1 : 0);
+            int partnerY = y + (side == 2 ? -1 : side == 3 ? 1 : 0);
+            cluster.entrances.push_back({x, y, partnerX, partnerY});
+        };
+
+        int runStart = -1;
+        for (int k = 0; k <= CHUNK_SIZE; ++k) {
+            bool open = k < CHUNK_SIZE && isOpen(k);
+            if (open && runStart < 0) {
+                runStart = k;
+            } else if (!open && runStart >= 0) {
+                int runEnd = k - 1;
+                if (runEnd - runStart + 1 < LONG_ENTRANCE_RUN) {
+                    addEntrance((runStart + runEnd) / 2);
+                } else {
+                    addEntrance(runStart);
+                    addEntrance(runEnd);
+                }
+                runStart = -1;
+            }
+        }
+    }
+
+    // 진입점 간 청크 내부 거리
+    size_t count = cluster.entrances.size();
+    cluster.distances.assign(count * count, UNREACHABLE);
+    for (size_t i = 0; i < count; ++i) {
+        const Entrance& from = cluster.entrances[i];
+        chunkDistances(chunk, from.x & CHUNK_MASK, from.y & CHUNK_MASK, entranceDistances);
+        for (size_t j = 0; j < count; ++j) {
+            const Entrance& to = cluster.entrances[j];
+            cluster.distances[i * count + j] = entranceDistances[localIndex(to.x, to.y)];
+        }
+    }
+}
+
+void ChunkGraph::pruneClusters(const Map* map) {
+    for (auto it = clusters.begin(); it != clusters.end();) {
+        int chunkX = ChunkTable::unpackX(it->first);
+        int chunkY = ChunkTable::unpackY(it->first);
+        if (map->getChunkRevision(chunkX, chunkY) == 0) {
+            it = clusters.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ChunkGraph::chunkDistances(const Chunk& chunk, int localX, int localY, float* out) {
+    std::fill(out, out + CHUNK_SIZE * CHUNK_SIZE, UNREACHABLE);
+    localOpen.clear();
+
+    int startCell = localY * CHUNK_SIZE + localX;
+    out[startCell] = 0.0f;
+    localOpen.push(startCell, 0.0f);
+
+    while (!localOpen.empty()) {
+        float distance = localOpen.topKey();
+        int current = localOpen.pop();
+        int x = current & CHUNK_MASK;
+        int y = current >> CHUNK_SHIFT;
+
+        for (int direction = 0; direction < 8; ++direction) {
+            int dx = NEIGHBOR_DX[direction];
+            int dy = NEIGHBOR_DY[direction];
+            int nx = x + dx;
+            int ny = y + dy;
+            if (nx < 0 || nx >= CHUNK_SIZE || ny < 0 || ny >= CHUNK_SIZE) continue;
+            if (chunk.tiles[ny][nx] != 0) continue;
+            // 대각선은 양 옆이 모두 열려 있어야 한다 (Pathfinder와 같은 규칙)
+            if (dx != 0 && dy != 0 && (chunk.tiles[y][nx] != 0 || chunk.tiles[ny][x] != 0)) continue;
+
+            int neighbor = ny * CHUNK_SIZE + nx;
+            float newDistance = distance + (dx == 0 || dy == 0 ? STRAIGHT_COST : DIAGONAL_COST);
+            if (newDistance >= out[neighbor]) continue;
+            bool queued = out[neighbor] != UNREACHABLE && localOpen.contains(neighbor);
+            out[neighbor] = newDistance;
+            if (queued) {
+                localOpen.decreaseKey(neighbor, newDistance);
+            } else {
+                localOpen.push(neighbor, newDistance);
+            }
+        }
+    }
+}
+
+int ChunkGraph::addNode(int x, int y, Cluster* cluster, int entrance) {
+    if (nodes.size() == nodes.capacity()) {
+        nodes.reserve(std::max<size_t>(256, nodes.capacity() * 2));
+        openSet.reserve(static_cast<int>(nodes.capacity()));
+    }
+    nodes.push_back({x, y, UNREACHABLE, -1, false, cluster, entrance});
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+int ChunkGraph::entranceNode(Cluster* cluster, int entrance) {
+    int& node = cluster->searchNodes[entrance];
+    if (node < 0) {
+        const Entrance& e = cluster->entrances[entrance];
+        node = addNode(e.x, e.y, cluster, entrance);
+    }
+    return node;
+}
+
+void ChunkGraph::relax(int from, int to, float cost, int endX, int endY) {
+    SearchNode& target = nodes[to];
+    if (target.closed) return;
+    float newGCost = nodes[from].gCost + cost;
+    if (newGCost >= target.gCost) return;
+
+    bool queued = target.gCost != UNREACHABLE;
+    target.gCost = newGCost;
+    target.parent = from;
+    float key = newGCost + Pathfinder::calculateHeuristic(target.x, target.y, endX, endY);
+    if (queued) {
+        openSet.decreaseKey(to, key);
+    } else {
+        openSet.push(to, key);
+    }
+}
+
+bool ChunkGraph::findAbstractPath(int startX, int startY, int endX, int endY, const Map* map, std::vector<PathPoint>& waypoints) {
+    waypoints.clear();
+    if (clusters.size() > MAX_CACHED_CLUSTERS) pruneClusters(map);
+
+    // 이전 탐색이 중간에 끝났을 수 있으므로 힙을 먼저 비운 뒤 노드를 초기화
+    openSet.clear();
+    nodes.clear();
+    if (++searchId == 0) {
+        for (auto& entry : clusters) entry.second.searchId = 0;
+        searchId = 1;
+    }
+
+    int endChunkX = endX >> CHUNK_SHIFT, endChunkY = endY >> CHUNK_SHIFT;
+    Cluster* startCluster = getCluster(map, startX >> CHUNK_SHIFT, startY >> CHUNK_SHIFT);
+    Cluster* endCluster = getCluster(map, endChunkX, endChunkY);
+    if (!startCluster || !endCluster) return false;
+
+    // 시작점/목적지는 그래프에 임시로 끼워 넣는다: 자기 청크 안의 거리만 따로 계산
+    chunkDistances(*map->findChunk(startX >> CHUNK_SHIFT, startY >> CHUNK_SHIFT),
+                   startX & CHUNK_MASK, startY & CHUNK_MASK, startDistances);
+    chunkDistances(*map->findChunk(endChunkX, endChunkY), endX & CHUNK_MASK, endY & CHUNK_MASK, endDistances);
+
+    int startNode = addNode(startX, startY, startCluster, -1);
+    int endNode = addNode(endX, endY, endCluster, -1);
+    nodes[startNode].gCost = 0.0f;
+    openSet.push(startNode, Pathfinder::calculateHeuristic(startX, startY, endX, endY));
+
+    bool found = false;
+    while (!openSet.empty()) {
+        int current = openSet.pop();
+        if (current == endNode) {
+            found = true;
+            break;
+        }
+        if (static_cast<int>(nodes.size()) > MAX_ABSTRACT_NODES) break;
+        nodes[current].closed = true;
+
+        // nodes는 relax 중에 커질 수 있으므로 필요한 값을 먼저 복사
+        int x = nodes[current].x;
+        int y = nodes[current].y;
+        Cluster* cluster = nodes[current].cluster;
+        int row = nodes[current].entrance;
+        int count = static_cast<int>(cluster->entrances.size());
+
+        if (row >= 0) {
+            // 경계 건너편 짝으로 가는 간선
+            const Entrance& entrance = cluster->entrances[row];
+            Cluster* other = getCluster(map, entrance.partnerX >> CHUNK_SHIFT, entrance.partnerY >> CHUNK_SHIFT);
+            if (other) {
+                for (int j = 0; j < static_cast<int>(other->entrances.size()); ++j) {
+                    const Entrance& partner = other->entrances[j];
+                    if (partner.x == entrance.partnerX && partner.y == entrance.partnerY &&
+                        partner.partnerX == x && partner.partnerY == y) {
+                        relax(current, entranceNode(other, j), STRAIGHT_COST, endX, endY);
+                        break;
+                    }
+                }
+            }
+        }
+
+        // 같은 청크의 다른 진입점으로 가는 간선 (캐시된 내부 거리, 시작점은 방금 계산한 거리)
+        if (current != endNode) {
+            for (int j = 0; j < count; ++j) {
+                if (j == row) continue;
+                const Entrance& entrance = cluster->entrances[j];
+                float distance = row >= 0 ? cluster->distances[row * count + j]
+                                          : startDistances[localIndex(entrance.x, entrance.y)];
+                if (distance != UNREACHABLE) {
+                    relax(current, entranceNode(cluster, j), distance, endX, endY);
+                }
+            }
+        }
+
+        // 목적지 청크 안이면 목적지로 바로 가는 간선
+        if (cluster == endCluster) {
+            float distance = endDistances[localIndex(x, y)];
+            if (distance != UNREACHABLE) relax(current, endNode, distance, endX, endY);
+        }
+    }
+
+    if (!found) return false;
+
+    // 청크 모서리의 진입점은 같은 타일이 두 번 나올 수 있으므로 연속한 중복은 건너뛴다
+    for (int node = endNode; node != -1; node = nodes[node].parent) {
+        if (!waypoints.empty() && waypoints.back().x == nodes[node].x && waypoints.back().y == nodes[node].y) continue;
+        waypoints.push_back({nodes[node].x, nodes[node].y});
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    return true;
+}
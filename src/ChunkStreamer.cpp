@@ -0,0 +1,112 @@
+#include "ChunkStreamer.h"
+#include "MapGenerator.h"
+#include "RegionStore.h"
+#include <chrono>
+#include <cmath>
+
+namespace {
+// 바라보는 방향과 일치할수록 우선순위를 이만큼(청크 단위 거리) 앞당긴다
+const float HEADING_WEIGHT = 1.0f;
+}
+
+ChunkStreamer::ChunkStreamer(const MapGenerator& mapGenerator)
+    : generator(mapGenerator), focusX(0.0f), focusY(0.0f), headingX(1.0f), headingY(0.0f),
+      regionStore(nullptr), stopping(false), ready(READY_CAPACITY), readIndex(0), writeIndex(0) {
+    worker = std::thread(&ChunkStreamer::workerLoop, this);
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    worker.join();
+}
+
+void ChunkStreamer::setFocus(float chunkX, float chunkY, float dirX, float dirY) {
+    std::lock_guard<std::mutex> lock(mutex);
+    focusX = chunkX;
+    focusY = chunkY;
+    headingX = dirX;
+    headingY = dirY;
+}
+
+void ChunkStreamer::request(int chunkX, int chunkY) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back({chunkX, chunkY});
+    }
+    wakeCondition.notify_one();
+}
+
+void ChunkStreamer::setRegionStore(RegionStore* store) {
+    std::lock_guard<std::mutex> lock(mutex);
+    regionStore = store;
+}
+
+const ChunkStreamer::ReadyChunk* ChunkStreamer::peekReady() const {
+    unsigned int read = readIndex.load(std::memory_order_relaxed);
+    if (read == writeIndex.load(std::memory_order_acquire)) return nullptr;
+    return &ready[read & (READY_CAPACITY - 1)];
+}
+
+void ChunkStreamer::popReady() {
+    readIndex.store(readIndex.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// 작을수록 먼저 생성 (mutex를 잡은 상태에서 호출)
+float ChunkStreamer::priority(const Request& request) const {
+    float dx = request.chunkX + 0.5f - focusX;
+    float dy = request.chunkY + 0.5f - focusY;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance < 1e-4f) return 0.0f;
+    return distance - HEADING_WEIGHT * (dx * headingX + dy * headingY) / distance;
+}
+
+void ChunkStreamer::workerLoop() {
+    while (true) {
+        Request next;
+        RegionStore* store;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (stopping) return;
+
+            // 요청은 많아야 수십 개이므로 매번 현재 기준점으로 가장 급한 것을 고른다
+            size_t best = 0;
+            float bestPriority = priority(requests[0]);
+            for (size_t i = 1; i < requests.size(); ++i) {
+                float p = priority(requests[i]);
+                if (p < bestPriority) {
+                    best = i;
+                    bestPriority = p;
+                }
+            }
+            next = requests[best];
+            requests[best] = requests.back();
+            requests.pop_back();
+            store = regionStore;
+        }
+
+        // 링 버퍼가 가득 차 있으면 메인 스레드가 비울 때까지 대기
+        unsigned int write = writeIndex.load(std::memory_order_relaxed);
+        while (write - readIndex.load(std::memory_order_acquire) >= READY_CAPACITY) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (stopping) return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // 슬롯에 바로 읽거나 생성한 뒤 writeIndex를 올려 공개
+        ReadyChunk& slot = ready[write & (READY_CAPACITY - 1)];
+        slot.chunkX = next.chunkX;
+        slot.chunkY = next.chunkY;
+        slot.fromStore = store && store->readChunk(next.chunkX, next.chunkY, slot.chunk);
+        if (!slot.fromStore) {
+            generator.generateChunk(next.chunkX, next.chunkY, slot.chunk);
+        }
+        writeIndex.store(write + 1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,102 @@
+#include "ChunkTable.h"
+
+namespace {
+const int INITIAL_CAPACITY = 64; // 2의 거듭제곱
+}
+
+ChunkTable::ChunkTable() : slots(INITIAL_CAPACITY), mask(INITIAL_CAPACITY - 1), count(0) {
+}
+
+uint64_t ChunkTable::hashKey(uint64_t key) {
+    // splitmix64 마무리 단계: 인접한 좌표가 서로 다른 슬롯으로 흩어지도록
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+// key가 있는 슬롯, 없으면 탐사가 멈춘 빈 슬롯의 인덱스
+int ChunkTable::findSlot(uint64_t key) const {
+    uint64_t index = hashKey(key) & mask;
+    while (slots[index].chunk && slots[index].key != key) {
+        index = (index + 1) & mask;
+    }
+    return static_cast<int>(index);
+}
+
+const Chunk* ChunkTable::find(int chunkX, int chunkY) const {
+    return slots[findSlot(packKey(chunkX, chunkY))].chunk.get();
+}
+
+Chunk* ChunkTable::find(int chunkX, int chunkY) {
+    return slots[findSlot(packKey(chunkX, chunkY))].chunk.get();
+}
+
+Chunk& ChunkTable::insert(int chunkX, int chunkY) {
+    uint64_t key = packKey(chunkX, chunkY);
+    int index = findSlot(key);
+    if (slots[index].chunk) return *slots[index].chunk;
+
+    // 적재율 1/2을 넘지 않도록 유지
+    if ((count + 1) * 2 > static_cast<int>(slots.size())) {
+        grow();
+        index = findSlot(key);
+    }
+
+    Slot& slot = slots[index];
+    if (!spareChunks.empty()) {
+        slot.chunk = std::move(spareChunks.back());
+        spareChunks.pop_back();
+        *slot.chunk = Chunk();
+    } else {
+        slot.chunk = std::make_unique<Chunk>();
+    }
+    slot.key = key;
+    slot.lastUsed = 0;
+    slot.revision = 0;
+    ++count;
+    return *slot.chunk;
+}
+
+bool ChunkTable::erase(int chunkX, int chunkY) {
+    uint64_t hole = findSlot(packKey(chunkX, chunkY));
+    if (!slots[hole].chunk) return false;
+    spareChunks.push_back(std::move(slots[hole].chunk));
+    --count;
+
+    // 뒤따르는 탐사 구간을 당겨 빈 슬롯을 메운다 (툼스톤 없이 삭제)
+    for (uint64_t next = (hole + 1) & mask; slots[next].chunk; next = (next + 1) & mask) {
+        uint64_t home = hashKey(slots[next].key) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = std::move(slots[next]);
+            hole = next;
+        }
+    }
+    return true;
+}
+
+void ChunkTable::touch(int chunkX, int chunkY, uint32_t tick) {
+    Slot& slot = slots[findSlot(packKey(chunkX, chunkY))];
+    if (slot.chunk) slot.lastUsed = tick;
+}
+
+void ChunkTable::setRevision(int chunkX, int chunkY, uint32_t revision) {
+    Slot& slot = slots[findSlot(packKey(chunkX, chunkY))];
+    if (slot.chunk) slot.revision = revision;
+}
+
+uint32_t ChunkTable::getRevision(int chunkX, int chunkY) const {
+    const Slot& slot = slots[findSlot(packKey(chunkX, chunkY))];
+    return slot.chunk ? slot.revision : 0;
+}
+
+void ChunkTable::grow() {
+    std::vector<Slot> oldSlots(slots.size() * 2);
+    oldSlots.swap(slots);
+    mask = slots.size() - 1;
+    for (Slot& slot : oldSlots) {
+        if (slot.chunk) slots[findSlot(slot.key)] = std::move(slot);
+    }
+}
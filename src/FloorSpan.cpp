@@ -0,0 +1,322 @@
+#include "FloorSpan.h"
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define JOOM_SPAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define JOOM_TARGET_AVX2
+#else
+#define JOOM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define JOOM_SPAN_X86 0
+#endif
+
+namespace {
+
+inline uint32_t fetchTexel(const uint32_t* pixels, int widthLog2, int heightLog2, float x, float y) {
+    int texX = static_cast<int>(x * static_cast<float>(1 << widthLog2)) & ((1 << widthLog2) - 1);
+    int texY = static_cast<int>(y * static_cast<float>(1 << heightLog2)) & ((1 << heightLog2) - 1);
+    return pixels[(texY << widthLog2) | texX];
+}
+
+// 좌표는 누적 대신 start + i * step 으로 계산해 모든 커널이 같은 텍셀을 고르도록 한다
+void floorSpanScalarRange(const FloorSpanParams& s, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        float x = s.startX + static_cast<float>(i) * s.stepX;
+        float y = s.startY + static_cast<float>(i) * s.stepY;
+        uint32_t floorColor = fetchTexel(s.floorPixels, s.floorWidthLog2, s.floorHeightLog2, x, y);
+        uint32_t ceilingColor = fetchTexel(s.ceilingPixels, s.ceilingWidthLog2, s.ceilingHeightLog2, x, y);
+        int lightLevel = s.lightLevels ? s.lightLevels[i] : s.lightLevel;
+        s.floorOut[i] = shadeColorFixed(floorColor, lightLevel);
+        s.ceilingOut[i] = shadeColorFixed(ceilingColor, lightLevel);
+    }
+}
+
+void floorSpanScalar(const FloorSpanParams& s) {
+    floorSpanScalarRange(s, 0, s.count);
+}
+
+#if JOOM_SPAN_X86
+
+// ---- SSE2: 4픽셀 ----
+
+inline __m128i texelIndexSSE2(__m128 x, __m128 y, __m128 scaleX, __m128 scaleY,
+                              __m128i maskX, __m128i maskY, __m128i shiftY) {
+    __m128i texX = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(x, scaleX)), maskX);
+    __m128i texY = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(y, scaleY)), maskY);
+    return _mm_or_si128(_mm_sll_epi32(texY, shiftY), texX);
+}
+
+inline __m128i gatherSSE2(const uint32_t* pixels, __m128i index) {
+    alignas(16) int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), index);
+    return _mm_setr_epi32(static_cast<int>(pixels[lanes[0]]), static_cast<int>(pixels[lanes[1]]),
+                          static_cast<int>(pixels[lanes[2]]), static_cast<int>(pixels[lanes[3]]));
+}
+
+// 채널을 16비트로 펼쳐 (c * light) >> 8 후 다시 8비트로 포화 압축.
+// lightLo는 픽셀 0, 1, lightHi는 픽셀 2, 3의 밝기
+inline __m128i shadeSSE2(__m128i color, __m128i lightLo, __m128i lightHi) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(color, zero), lightLo), 8);
+    __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(color, zero), lightHi), 8);
+    return _mm_packus_epi16(lo, hi);
+}
+
+// 16비트 밝기 4개 [l0 l1 l2 l3]를 shadeSSE2가 쓰는 [l0 l0 l0 256 l1 l1 l1 256], [l2 .. l3 ..] 로 펼친다
+inline void expandLightSSE2(__m128i levels, __m128i& lightLo, __m128i& lightHi) {
+    const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i alpha = _mm_setr_epi16(0, 0, 0, 256, 0, 0, 0, 256);
+    __m128i pairs = _mm_unpacklo_epi16(levels, levels);
+    lightLo = _mm_or_si128(_mm_and_si128(_mm_unpacklo_epi32(pairs, pairs), colorMask), alpha);
+    lightHi = _mm_or_si128(_mm_and_si128(_mm_unpackhi_epi32(pairs, pairs), colorMask), alpha);
+}
+
+void floorSpanSSE2(const FloorSpanParams& s) {
+    const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const __m128 startX = _mm_set1_ps(s.startX), startY = _mm_set1_ps(s.startY);
+    const __m128 stepX = _mm_set1_ps(s.stepX), stepY = _mm_set1_ps(s.stepY);
+
+    const __m128 floorScaleX = _mm_set1_ps(static_cast<float>(1 << s.floorWidthLog2));
+    const __m128 floorScaleY = _mm_set1_ps(static_cast<float>(1 << s.floorHeightLog2));
+    const __m128i floorMaskX = _mm_set1_epi32((1 << s.floorWidthLog2) - 1);
+    const __m128i floorMaskY = _mm_set1_epi32((1 << s.floorHeightLog2) - 1);
+    const __m128i floorShift = _mm_cvtsi32_si128(s.floorWidthLog2);
+
+    const __m128 ceilingScaleX = _mm_set1_ps(static_cast<float>(1 << s.ceilingWidthLog2));
+    const __m128 ceilingScaleY = _mm_set1_ps(static_cast<float>(1 << s.ceilingHeightLog2));
+    const __m128i ceilingMaskX = _mm_set1_epi32((1 << s.ceilingWidthLog2) - 1);
+    const __m128i ceilingMaskY = _mm_set1_epi32((1 << s.ceilingHeightLog2) - 1);
+    const __m128i ceilingShift = _mm_cvtsi32_si128(s.ceilingWidthLog2);
+
+    // 16비트 레인 순서는 픽셀당 B, G, R, A. 알파는 256을 곱해 그대로 유지
+    const short L = static_cast<short>(s.lightLevel);
+    const __m128i light = _mm_setr_epi16(L, L, L, 256, L, L, L, 256);
+
+    int i = 0;
+    for (; i + 4 <= s.count; i += 4) {
+        __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), laneOffsets);
+        __m128 x = _mm_add_ps(startX, _mm_mul_ps(index, stepX));
+        __m128 y = _mm_add_ps(startY, _mm_mul_ps(index, stepY));
+
+        __m128i floorIndex = texelIndexSSE2(x, y, floorScaleX, floorScaleY, floorMaskX, floorMaskY, floorShift);
+        __m128i ceilingIndex = texelIndexSSE2(x, y, ceilingScaleX, ceilingScaleY, ceilingMaskX, ceilingMaskY, ceilingShift);
+
+        __m128i floorColor = gatherSSE2(s.floorPixels, floorIndex);
+        __m128i ceilingColor = gatherSSE2(s.ceilingPixels, ceilingIndex);
+
+        __m128i lightLo = light, lightHi = light;
+        if (s.lightLevels) {
+            expandLightSSE2(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s.lightLevels + i)), lightLo, lightHi);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s.floorOut + i), shadeSSE2(floorColor, lightLo, lightHi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s.ceilingOut + i), shadeSSE2(ceilingColor, lightLo, lightHi));
+    }
+    floorSpanScalarRange(s, i, s.count);
+}
+
+// ---- AVX2: 8픽셀, 하드웨어 gather ----
+
+JOOM_TARGET_AVX2
+inline __m256i texelIndexAVX2(__m256 x, __m256 y, __m256 scaleX, __m256 scaleY,
+                              __m256i maskX, __m256i maskY, __m128i shiftY) {
+    __m256i texX = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(x, scaleX)), maskX);
+    __m256i texY = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(y, scaleY)), maskY);
+    return _mm256_or_si256(_mm256_sll_epi32(texY, shiftY), texX);
+}
+
+// unpack/pack은 128비트 레인 단위로 동작하므로 짝을 맞추면 픽셀 순서가 보존된다.
+// lightLo는 픽셀 0, 1 | 4, 5, lightHi는 픽셀 2, 3 | 6, 7의 밝기
+JOOM_TARGET_AVX2
+inline __m256i shadeAVX2(__m256i color, __m256i lightLo, __m256i lightHi) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(color, zero), lightLo), 8);
+    __m256i hi = _mm256_srli_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(color, zero), lightHi), 8);
+    return _mm256_packus_epi16(lo, hi);
+}
+
+// 16비트 밝기 8개를 레인별로 나눠 (0~3 | 4~7) SSE2와 같은 방식으로 펼친다
+JOOM_TARGET_AVX2
+inline void expandLightAVX2(__m128i levels, __m256i& lightLo, __m256i& lightHi) {
+    const __m256i colorMask = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+    const __m256i alpha = _mm256_setr_epi16(0, 0, 0, 256, 0, 0, 0, 256, 0, 0, 0, 256, 0, 0, 0, 256);
+    __m256i split = _mm256_inserti128_si256(_mm256_castsi128_si256(levels), _mm_unpackhi_epi64(levels, levels), 1);
+    __m256i pairs = _mm256_unpacklo_epi16(split, split);
+    lightLo = _mm256_or_si256(_mm256_and_si256(_mm256_unpacklo_epi32(pairs, pairs), colorMask), alpha);
+    lightHi = _mm256_or_si256(_mm256_and_si256(_mm256_unpackhi_epi32(pairs, pairs), colorMask), alpha);
+}
+
+JOOM_TARGET_AVX2
+void floorSpanAVX2(const FloorSpanParams& s) {
+    const __m256 laneOffsets = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 startX = _mm256_set1_ps(s.startX), startY = _mm256_set1_ps(s.startY);
+    const __m256 stepX = _mm256_set1_ps(s.stepX), stepY = _mm256_set1_ps(s.stepY);
+
+    const __m256 floorScaleX = _mm256_set1_ps(static_cast<float>(1 << s.floorWidthLog2));
+    const __m256 floorScaleY = _mm256_set1_ps(static_cast<float>(1 << s.floorHeightLog2));
+    const __m256i floorMaskX = _mm256_set1_epi32((1 << s.floorWidthLog2) - 1);
+    const __m256i floorMaskY = _mm256_set1_epi32((1 << s.floorHeightLog2) - 1);
+    const __m128i floorShift = _mm_cvtsi32_si128(s.floorWidthLog2);
+
+    const __m256 ceilingScaleX = _mm256_set1_ps(static_cast<float>(1 << s.ceilingWidthLog2));
+    const __m256 ceilingScaleY = _mm256_set1_ps(static_cast<float>(1 << s.ceilingHeightLog2));
+    const __m256i ceilingMaskX = _mm256_set1_epi32((1 << s.ceilingWidthLog2) - 1);
+    const __m256i ceilingMaskY = _mm256_set1_epi32((1 << s.ceilingHeightLog2) - 1);
+    const __m128i ceilingShift = _mm_cvtsi32_si128(s.ceilingWidthLog2);
+
+    const short L = static_cast<short>(s.lightLevel);
+    const __m256i light = _mm256_setr_epi16(L, L, L, 256, L, L, L, 256, L, L, L, 256, L, L, L, 256);
+
+    const int* floorBase = reinterpret_cast<const int*>(s.floorPixels);
+    const int* ceilingBase = reinterpret_cast<const int*>(s.ceilingPixels);
+
+    int i = 0;
+    for (; i + 8 <= s.count; i += 8) {
+        __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), laneOffsets);
+        __m256 x = _mm256_add_ps(startX, _mm256_mul_ps(index, stepX));
+        __m256 y = _mm256_add_ps(startY, _mm256_mul_ps(index, stepY));
+
+        __m256i floorIndex = texelIndexAVX2(x, y, floorScaleX, floorScaleY, floorMaskX, floorMaskY, floorShift);
+        __m256i ceilingIndex = texelIndexAVX2(x, y, ceilingScaleX, ceilingScaleY, ceilingMaskX, ceilingMaskY, ceilingShift);
+
+        __m256i floorColor = _mm256_i32gather_epi32(floorBase, floorIndex, 4);
+        __m256i ceilingColor = _mm256_i32gather_epi32(ceilingBase, ceilingIndex, 4);
+
+        __m256i lightLo = light, lightHi = light;
+        if (s.lightLevels) {
+            expandLightAVX2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.lightLevels + i)), lightLo, lightHi);
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.floorOut + i), shadeAVX2(floorColor, lightLo, lightHi));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.ceilingOut + i), shadeAVX2(ceilingColor, lightLo, lightHi));
+    }
+    floorSpanScalarRange(s, i, s.count);
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    // OS가 YMM 레지스터 저장을 지원하는지 확인
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // JOOM_SPAN_X86
+
+} // namespace
+
+bool isSpanKernelSupported(SpanKernel kernel) {
+    switch (kernel) {
+        case SpanKernel::Scalar: return true;
+#if JOOM_SPAN_X86
+        case SpanKernel::SSE2: return true;
+        case SpanKernel::AVX2: return cpuHasAVX2();
+#endif
+        default: return false;
+    }
+}
+
+SpanKernel detectSpanKernel() {
+    if (isSpanKernelSupported(SpanKernel::AVX2)) return SpanKernel::AVX2;
+    if (isSpanKernelSupported(SpanKernel::SSE2)) return SpanKernel::SSE2;
+    return SpanKernel::Scalar;
+}
+
+FloorSpanFunc getFloorSpanKernel(SpanKernel kernel) {
+    if (!isSpanKernelSupported(kernel)) return floorSpanScalar;
+    switch (kernel) {
+#if JOOM_SPAN_X86
+        case SpanKernel::SSE2: return floorSpanSSE2;
+        case SpanKernel::AVX2: return floorSpanAVX2;
+#endif
+        default: return floorSpanScalar;
+    }
+}
+
+const char* getSpanKernelName(SpanKernel kernel) {
+    switch (kernel) {
+        case SpanKernel::SSE2: return "SSE2";
+        case SpanKernel::AVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
+
+void floorSpanFloat(const FloorSpanParams& s, float lighting, const float* pixelLighting) {
+    for (int i = 0; i < s.count; ++i) {
+        float x = s.startX + static_cast<float>(i) * s.stepX;
+        float y = s.startY + static_cast<float>(i) * s.stepY;
+        uint32_t floorColor = fetchTexel(s.floorPixels, s.floorWidthLog2, s.floorHeightLog2, x, y);
+        uint32_t ceilingColor = fetchTexel(s.ceilingPixels, s.ceilingWidthLog2, s.ceilingHeightLog2, x, y);
+        float pixelLight = pixelLighting ? pixelLighting[i] : lighting;
+        s.floorOut[i] = shadeColorFloat(floorColor, pixelLight);
+        s.ceilingOut[i] = shadeColorFloat(ceilingColor, pixelLight);
+    }
+}
+
+int compareFloorSpanKernels(SpanKernel kernel, SpanKernel reference, int spanCount) {
+    FloorSpanFunc testFunc = getFloorSpanKernel(kernel);
+    FloorSpanFunc referenceFunc = getFloorSpanKernel(reference);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+    std::uniform_real_distribution<float> step(-0.05f, 0.05f);
+    std::uniform_int_distribution<int> light(0, 256);
+    std::uniform_int_distribution<int> length(1, 800);
+
+    // 크기가 서로 다른 두 텍스처로 마스크/시프트 계산도 확인
+    std::vector<uint32_t> floorTexture(64 * 64), ceilingTexture(32 * 128);
+    for (uint32_t& texel : floorTexture) texel = rng();
+    for (uint32_t& texel : ceilingTexture) texel = rng();
+
+    std::vector<uint32_t> floorA(800), ceilingA(800), floorB(800), ceilingB(800);
+    std::vector<uint16_t> lightLevels(800);
+    int mismatches = 0;
+    for (int n = 0; n < spanCount; ++n) {
+        FloorSpanParams span;
+        span.floorPixels = floorTexture.data();
+        span.floorWidthLog2 = 6;
+        span.floorHeightLog2 = 6;
+        span.ceilingPixels = ceilingTexture.data();
+        span.ceilingWidthLog2 = 5;
+        span.ceilingHeightLog2 = 7;
+        span.startX = position(rng);
+        span.startY = position(rng);
+        span.stepX = step(rng);
+        span.stepY = step(rng);
+        span.lightLevel = light(rng);
+        span.count = length(rng);
+        // 절반은 픽셀별 밝기로 그린다
+        span.lightLevels = nullptr;
+        if (n & 1) {
+            for (int i = 0; i < span.count; ++i) lightLevels[i] = static_cast<uint16_t>(light(rng));
+            span.lightLevels = lightLevels.data();
+        }
+
+        span.floorOut = floorA.data();
+        span.ceilingOut = ceilingA.data();
+        testFunc(span);
+        span.floorOut = floorB.data();
+        span.ceilingOut = ceilingB.data();
+        referenceFunc(span);
+
+        for (int i = 0; i < span.count; ++i) {
+            if (floorA[i] != floorB[i]) ++mismatches;
+            if (ceilingA[i] != ceilingB[i]) ++mismatches;
+        }
+    }
+    return mismatches;
+}
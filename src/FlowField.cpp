@@ -0,0 +1,132 @@
+#include "FlowField.h"
+#include "Chunk.h"
+#include "Map.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const uint16_t STRAIGHT_COST = 2;
+const uint16_t DIAGONAL_COST = 3; // 2 * sqrt(2)의 정수 근사
+const uint8_t NO_FLOW = 0xFF;
+
+const int NEIGHBOR_DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+const int NEIGHBOR_DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+const uint8_t OPPOSITE[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+}
+
+FlowField::FlowField()
+    : targetX(0), targetY(0), originX(0), originY(0), revision(0), valid(false), rebuildCount(0),
+      distance(FIELD_SIZE * FIELD_SIZE, UNREACHABLE), flow(FIELD_SIZE * FIELD_SIZE, NO_FLOW),
+      blocked(FIELD_SIZE * FIELD_SIZE, 1) {}
+
+uint32_t FlowField::windowRevision(const Map* map) const {
+    // 창을 덮는 청크들의 리비전을 섞는다. 청크가 로드/제거되거나 타일이 바뀌면 달라진다
+    uint32_t hash = 2166136261u;
+    int minChunkX = originX >> CHUNK_SHIFT, maxChunkX = (originX + FIELD_SIZE - 1) >> CHUNK_SHIFT;
+    int minChunkY = originY >> CHUNK_SHIFT, maxChunkY = (originY + FIELD_SIZE - 1) >> CHUNK_SHIFT;
+    for (int chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY) {
+        for (int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX) {
+            hash = (hash ^ map->getChunkRevision(chunkX, chunkY)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+bool FlowField::update(const Map* map, float playerX, float playerY) {
+    int tileX = static_cast<int>(std::floor(playerX));
+    int tileY = static_cast<int>(std::floor(playerY));
+    if (valid && tileX == targetX && tileY == targetY && windowRevision(map) == revision) {
+        return false;
+    }
+
+    targetX = tileX;
+    targetY = tileY;
+    originX = tileX - FIELD_RADIUS;
+    originY = tileY - FIELD_RADIUS;
+    revision = windowRevision(map);
+    rebuild(map);
+    valid = true;
+    ++rebuildCount;
+    return true;
+}
+
+void FlowField::rebuild(const Map* map) {
+    std::fill(distance.begin(), distance.end(), UNREACHABLE);
+    std::fill(flow.begin(), flow.end(), NO_FLOW);
+    for (int localY = 0; localY < FIELD_SIZE; ++localY) {
+        for (int localX = 0; localX < FIELD_SIZE; ++localX) {
+            blocked[localY * FIELD_SIZE + localX] = map->getWallType(originX + localX, originY + localY) != 0;
+        }
+    }
+
+    int targetCell = FIELD_RADIUS * FIELD_SIZE + FIELD_RADIUS;
+    if (blocked[targetCell]) return;
+
+    for (std::vector<int>& bucket : buckets) bucket.clear();
+    distance[targetCell] = 0;
+    buckets[0].push_back(targetCell);
+    int pending = 1;
+
+    // Dial 알고리즘: 거리 d의 버킷을 차례로 비운다. 간선 비용이 3 이하라 버킷 4개를 돌려 쓴다
+    for (uint32_t current = 0; pending > 0; ++current) {
+        std::vector<int>& bucket = buckets[current & 3];
+        // 처리 중에 같은 버킷에 추가되는 일은 없다 (비용이 항상 1 이상, 4 미만)
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            int cell = bucket[i];
+            --pending;
+            if (distance[cell] != current) continue; // 더 짧은 거리로 이미 처리된 항목
+
+            int localX = cell % FIELD_SIZE;
+            int localY = cell / FIELD_SIZE;
+            for (int direction = 0; direction < 8; ++direction) {
+                int dx = NEIGHBOR_DX[direction];
+                int dy = NEIGHBOR_DY[direction];
+                int nextX = localX + dx;
+                int nextY = localY + dy;
+                if (nextX < 0 || nextX >= FIELD_SIZE || nextY < 0 || nextY >= FIELD_SIZE) continue;
+                int neighbor = nextY * FIELD_SIZE + nextX;
+                if (blocked[neighbor]) continue;
+
+                // 대각선은 양 옆이 모두 열려 있어야 한다 (Pathfinder와 같은 규칙)
+                bool diagonal = dx != 0 && dy != 0;
+                if (diagonal && (blocked[localY * FIELD_SIZE + nextX] || blocked[nextY * FIELD_SIZE + localX])) continue;
+
+                uint32_t newDistance = current + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+                if (newDistance >= distance[neighbor]) continue;
+                distance[neighbor] = static_cast<uint16_t>(newDistance);
+                flow[neighbor] = OPPOSITE[direction]; // 이웃에서 현재 칸으로 돌아오는 방향
+                buckets[newDistance & 3].push_back(neighbor);
+                ++pending;
+            }
+        }
+        bucket.clear();
+    }
+}
+
+bool FlowField::getDirection(float x, float y, float& dirX, float& dirY) const {
+    if (!valid) return false;
+    int tileX = static_cast<int>(std::floor(x));
+    int tileY = static_cast<int>(std::floor(y));
+    int localX = tileX - originX;
+    int localY = tileY - originY;
+    if (localX < 0 || localX >= FIELD_SIZE || localY < 0 || localY >= FIELD_SIZE) return false;
+
+    uint8_t direction = flow[localY * FIELD_SIZE + localX];
+    if (direction == NO_FLOW) return false;
+
+    // 다음 타일 중앙을 향한다
+    float dx = tileX + NEIGHBOR_DX[direction] + 0.5f - x;
+    float dy = tileY + NEIGHBOR_DY[direction] + 0.5f - y;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 0.0001f) return false;
+    dirX = dx / length;
+    dirY = dy / length;
+    return true;
+}
+
+uint16_t FlowField::getDistance(int tileX, int tileY) const {
+    int localX = tileX - originX;
+    int localY = tileY - originY;
+    if (!valid || localX < 0 || localX >= FIELD_SIZE || localY < 0 || localY >= FIELD_SIZE) return UNREACHABLE;
+    return distance[localY * FIELD_SIZE + localX];
+}
@@ -6,17 +6,22 @@
 Game::Game() : window(nullptr), renderer(nullptr), running(false), 
                player(nullptr), map(nullptr), gameRenderer(nullptr),
                textureManager(nullptr), hud(nullptr), lightSystem(nullptr),
-               audioManager(nullptr), itemManager(nullptr),
+               audioManager(nullptr), itemManager(nullptr), entityGrid(nullptr),
+               monsterSystem(nullptr),
                frameCount(0), fpsTimer(0), currentFPS(60.0f),
                fKeyPressed(false), fKeyWasPressed(false), 
-               isMoving(false), wasMoving(false), lastFrameTime(0) {
+               isMoving(false), wasMoving(false), itemsCollected(0), lastFrameCounter(0), simulationAccumulator(0.0),
+               previousPlayerX(0.0f), previousPlayerY(0.0f), previousPlayerAngle(0.0f),
+               renderSnapshot(0), simulationPending(false), simulationStopping(false), pendingFrameTime(0.0) {
 }
 
 Game::~Game() {
     cleanup();
 }
 
-bool Game::initialize(const std::string& resourcePath) {
+bool Game::initialize(const std::string& resourcePath, const GameOptions& gameOptions) {
+    options = gameOptions;
+
     // SDL 초기화
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
@@ -34,7 +39,8 @@ bool Game::initialize(const std::string& resourcePath) {
     }
     
     // 렌더러 생성 (VSync 활성화)
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | (options.vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
     if (renderer == nullptr) {
         // VSync 실패시 일반 가속 렌더러로 대체
         renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
@@ -53,9 +59,33 @@ bool Game::initialize(const std::string& resourcePath) {
     }
     
     // 게임 객체들 초기화
-    map = new Map();
+    map = options.fixedSeed ? new Map(options.seed) : new Map();
+    // 청크 저장은 요청했을 때만. 리소스 폴더(앱 번들 안일 수 있음)가 아니라 사용자 데이터 폴더에 기록한다
+    if (options.persistChunks) {
+        std::string mapRoot = options.mapDirectory;
+        if (mapRoot.empty()) {
+            char* prefPath = SDL_GetPrefPath("Joom", "Joom");
+            if (prefPath) {
+                mapRoot = std::string(prefPath) + "maps";
+                SDL_free(prefPath);
+            }
+        }
+        if (mapRoot.empty()) {
+            std::cerr << "No writable data directory, chunk persistence disabled: " << SDL_GetError() << std::endl;
+        } else {
+            if (!options.fixedSeed) {
+                std::cout << "Persisting a random-seed world; pass --seed " << map->getSeed() << " to load it again" << std::endl;
+            }
+            map->enablePersistence(mapRoot + "/seed_" + std::to_string(map->getSeed()));
+        }
+    }
+    if (options.chunkBudget > 0) {
+        map->setResidencyBudget(options.chunkBudget);
+    }
     map->generateInitialChunk();
-    itemManager = new ItemManager();
+    entityGrid = new SpatialGrid();
+    itemManager = new ItemManager(entityGrid);
+    monsterSystem = new MonsterSystem(entityGrid, map->getSeed());
     
     // Find a safe starting position in the initial chunk
     float startX = 8.5f, startY = 8.5f; // Default fallback
@@ -72,17 +102,31 @@ bool Game::initialize(const std::string& resourcePath) {
     std::cout << "Player spawned at safe location: (" << startX << ", " << startY << ")" << std::endl;
     
     player = new Player(startX, startY, 0.0f);
+    previousPlayerX = startX;
+    previousPlayerY = startY;
+    previousPlayerAngle = 0.0f;
     textureManager = new TextureManager(renderer, resourcePath + "textures/");
     lightSystem = new LightSystem();
     gameRenderer = new Renderer(renderer, WINDOW_WIDTH, WINDOW_HEIGHT, textureManager, lightSystem);
+    gameRenderer->setWallCaster(options.wallCaster);
+    gameRenderer->setThreadCount(options.renderThreads);
+    gameRenderer->setSpanKernel(options.spanKernel);
+    gameRenderer->setLightingMode(options.lightingMode);
+    gameRenderer->setMipmapping(options.mipmapping);
     hud = new HUD(renderer, WINDOW_WIDTH, WINDOW_HEIGHT);
 
     // 텍스처 초기화
     gameRenderer->initializeTextures();
+
+    // 첫 프레임은 시작 상태를 그린다
+    captureSnapshot(snapshots[0]);
+    snapshots[1] = snapshots[0];
+    renderSnapshot = 0;
+    std::cout << "Simulation: " << (options.pipelined ? "pipelined" : "serial") << std::endl;
     
     // FPS 타이머 초기화
-    fpsTimer = SDL_GetTicks();
-    lastFrameTime = SDL_GetTicks();
+    fpsTimer = SDL_GetPerformanceCounter();
+    lastFrameCounter = SDL_GetPerformanceCounter();
     
     running = true;
     
@@ -115,39 +159,120 @@ void Game::loadCustomSounds(const std::string& resourcePath) {
 }
 
 void Game::run() {
-    const int TARGET_FPS = 60;
-    const int FRAME_DELAY = 1000 / TARGET_FPS;
-    
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    if (options.pipelined) {
+        simulationStopping = false;
+        simulationThread = std::thread(&Game::simulationLoop, this);
+    }
+
     while (running) {
-        Uint32 frameStart = SDL_GetTicks();
-        
-        // deltaTime 계산
-        Uint32 currentTime = SDL_GetTicks();
-        float deltaTime = (currentTime - lastFrameTime) / 1000.0f;
-        lastFrameTime = currentTime;
-        
-        // deltaTime 제한
-        deltaTime = std::max(1.0f / 120.0f, std::min(deltaTime, 1.0f / 30.0f));
-        
-        handleEvents(deltaTime);
-        update(deltaTime);
-        render();
+        Uint64 frameStart = SDL_GetPerformanceCounter();
+        double frameTime = (frameStart - lastFrameCounter) / frequency;
+        lastFrameCounter = frameStart;
+
+        handleEvents();
+        if (options.pipelined) {
+            // 동기화 지점: 맡겨 둔 시뮬레이션이 끝나면 스냅샷을 바꾸고, 아무도 맵을 읽지 않는 동안 맵/조명을 고친다.
+            // 그다음 프레임의 시뮬레이션은 이번 스냅샷을 그리는 동안 시뮬레이션 스레드에서 진행된다 (화면은 한 프레임 늦음)
+            waitForSimulation();
+            renderSnapshot = 1 - renderSnapshot;
+            synchronizeWorld(snapshots[renderSnapshot]);
+            startSimulation(frameTime);
+        } else {
+            // 몬스터 광원은 직전 프레임 스냅샷을 따른다 (한 프레임 늦음)
+            synchronizeWorld(snapshots[renderSnapshot]);
+            simulateFrame(frameTime, movementInput, snapshots[1 - renderSnapshot]);
+            renderSnapshot = 1 - renderSnapshot;
+        }
+        applySnapshot(snapshots[renderSnapshot]);
+        render(snapshots[renderSnapshot]);
         calculateFPS();
-        
-        // 프레임 제한
-        int frameTime = SDL_GetTicks() - frameStart;
-        if (FRAME_DELAY > frameTime) {
-            SDL_Delay(FRAME_DELAY - frameTime);
+
+        if (options.maxFPS > 0) {
+            waitForNextFrame(frameStart);
         }
     }
+    stopSimulation();
+}
+
+void Game::simulateFrame(double frameTime, const MovementInput& input, FrameSnapshot& snapshot) {
+    // 창을 끌거나 청크 로드가 길어져 멈췄던 시간을 한꺼번에 따라잡지 않도록 제한
+    simulationAccumulator += std::min(frameTime, MAX_FRAME_TIME);
+
+    // 흐른 시간만큼 고정 간격으로 시뮬레이션 (화면 프레임률과 무관하게 같은 결과)
+    while (simulationAccumulator >= SIMULATION_STEP) {
+        stepSimulation(static_cast<float>(SIMULATION_STEP), input);
+        simulationAccumulator -= SIMULATION_STEP;
+    }
+    captureSnapshot(snapshot);
+}
+
+void Game::simulationLoop() {
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    while (true) {
+        simulationCondition.wait(lock, [this] { return simulationPending || simulationStopping; });
+        if (simulationStopping) return;
+
+        // 맡은 프레임을 처리하는 동안 메인 스레드는 pending* 값과 뒤쪽 스냅샷을 건드리지 않는다
+        lock.unlock();
+        simulateFrame(pendingFrameTime, pendingInput, snapshots[1 - renderSnapshot]);
+        lock.lock();
+
+        simulationPending = false;
+        simulationCondition.notify_all();
+    }
+}
+
+void Game::startSimulation(double frameTime) {
+    std::lock_guard<std::mutex> lock(simulationMutex);
+    pendingFrameTime = frameTime;
+    pendingInput = movementInput;
+    simulationPending = true;
+    simulationCondition.notify_all();
 }
 
-void Game::handleEvents(float deltaTime) {
+void Game::waitForSimulation() {
+    std::unique_lock<std::mutex> lock(simulationMutex);
+    simulationCondition.wait(lock, [this] { return !simulationPending; });
+}
+
+void Game::stopSimulation() {
+    if (!simulationThread.joinable()) return;
+    // 처리 중인 프레임은 끝까지 마치게 한다
+    waitForSimulation();
+    {
+        std::lock_guard<std::mutex> lock(simulationMutex);
+        simulationStopping = true;
+    }
+    simulationCondition.notify_all();
+    simulationThread.join();
+}
+
+void Game::waitForNextFrame(Uint64 frameStart) {
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 target = frameStart + frequency / options.maxFPS;
+    // SDL_Delay는 밀리초 단위라 너무 늦게 깨어날 수 있다. 2ms 넘게 남았을 때만 재우고 나머지는 카운터를 보며 기다린다
+    for (Uint64 now = SDL_GetPerformanceCounter(); now < target; now = SDL_GetPerformanceCounter()) {
+        double remainingMs = (target - now) * 1000.0 / frequency;
+        if (remainingMs > 2.0) {
+            SDL_Delay(static_cast<Uint32>(remainingMs - 1.0));
+        }
+    }
+}
+
+void Game::handleEvents() {
     SDL_Event e;
     while (SDL_PollEvent(&e) != 0) {
         if (e.type == SDL_QUIT) {
             running = false;
         } else if (e.type == SDL_KEYDOWN) {
+            // R키: 벽 레이캐스터 전환 (DDA <-> 고정 스텝, 프로파일 비교용)
+            if (e.key.keysym.sym == SDLK_r) {
+                bool useDDA = gameRenderer->getWallCaster() != WallCaster::DDA;
+                gameRenderer->setWallCaster(useDDA ? WallCaster::DDA : WallCaster::RayMarch);
+                std::cout << "Wall caster: " << (useDDA ? "DDA" : "RayMarch") << std::endl;
+            }
+
             // 숫자 키로 커스텀 사운드 테스트
             if (audioManager && audioManager->isInitialized()) {
                 switch (e.key.keysym.sym) {
@@ -164,37 +289,19 @@ void Game::handleEvents(float deltaTime) {
     
     // 키보드 상태 확인
     const Uint8* currentKeyStates = SDL_GetKeyboardState(NULL);
-    
-    // 이동 상태 추적
-    isMoving = false;
-    
-    // 이동 처리
-    if (currentKeyStates[SDL_SCANCODE_W]) {
-        player->moveForward(deltaTime, map);
-        isMoving = true;
-    }
-    if (currentKeyStates[SDL_SCANCODE_S]) {
-        player->moveBackward(deltaTime, map);
-        isMoving = true;
-    }
-    if (currentKeyStates[SDL_SCANCODE_A]) {
-        player->strafeLeft(deltaTime, map);
-        isMoving = true;
-    }
-    if (currentKeyStates[SDL_SCANCODE_D]) {
-        player->strafeRight(deltaTime, map);
-        isMoving = true;
-    }
-    if (currentKeyStates[SDL_SCANCODE_LEFT]) {
-        player->rotateLeft(deltaTime);
-    }
-    if (currentKeyStates[SDL_SCANCODE_RIGHT]) {
-        player->rotateRight(deltaTime);
-    }
+
     if (currentKeyStates[SDL_SCANCODE_ESCAPE]) {
         running = false;
     }
 
+    // 이동 키는 여기서 읽어 두고 시뮬레이션 스텝에서 적용한다
+    movementInput.forward = currentKeyStates[SDL_SCANCODE_W];
+    movementInput.backward = currentKeyStates[SDL_SCANCODE_S];
+    movementInput.strafeLeft = currentKeyStates[SDL_SCANCODE_A];
+    movementInput.strafeRight = currentKeyStates[SDL_SCANCODE_D];
+    movementInput.turnLeft = currentKeyStates[SDL_SCANCODE_LEFT];
+    movementInput.turnRight = currentKeyStates[SDL_SCANCODE_RIGHT];
+
     // Volume controls (handle once per press)
     static bool minusWasPressed = false;
     static bool equalsWasPressed = false;
@@ -212,11 +319,6 @@ void Game::handleEvents(float deltaTime) {
     minusWasPressed = minusIsPressed;
     equalsWasPressed = equalsIsPressed;
     
-    // 발자국 소리 재생
-    if (audioManager && audioManager->isInitialized() && isMoving) {
-        audioManager->playFootstep();
-    }
-    
     // F키 토글 (손전등)
     fKeyPressed = currentKeyStates[SDL_SCANCODE_F];
     if (fKeyPressed && !fKeyWasPressed) {
@@ -234,40 +336,179 @@ void Game::handleEvents(float deltaTime) {
     
     // 조명 조절 키들은 기존과 동일...
     // (간결성을 위해 생략, 필요시 추가)
+}
+
+// 누르고 있는 이동/회전 키는 시뮬레이션 스텝마다 적용한다 (토글 키는 handleEvents에서 프레임마다)
+void Game::processMovement(float deltaTime, const MovementInput& input) {
+    // 이동 상태 추적
+    isMoving = false;
+    
+    // 이동 처리
+    if (input.forward) {
+        player->moveForward(deltaTime, map);
+        isMoving = true;
+    }
+    if (input.backward) {
+        player->moveBackward(deltaTime, map);
+        isMoving = true;
+    }
+    if (input.strafeLeft) {
+        player->strafeLeft(deltaTime, map);
+        isMoving = true;
+    }
+    if (input.strafeRight) {
+        player->strafeRight(deltaTime, map);
+        isMoving = true;
+    }
+    if (input.turnLeft) {
+        player->rotateLeft(deltaTime);
+    }
+    if (input.turnRight) {
+        player->rotateRight(deltaTime);
+    }
     
     wasMoving = isMoving;
 }
 
+void Game::stepSimulation(float deltaTime, const MovementInput& input) {
+    // 화면 보간용으로 이번 스텝 이전 상태를 남긴다 (몬스터는 MonsterSystem이 직접 보관)
+    previousPlayerX = player->getX();
+    previousPlayerY = player->getY();
+    previousPlayerAngle = player->getAngle();
+
+    processMovement(deltaTime, input);
+    update(deltaTime);
+}
+
 void Game::update(float deltaTime) {
-    // 플레이어 위치에 따라 청크 로드
-    map->checkAndLoadChunks(player->getX(), player->getY());
+    // 몬스터 배치/제거 후 일괄 갱신
+    monsterSystem->populate(map, player->getX(), player->getY(), options.monsterCount);
+    monsterSystem->update(map, player->getX(), player->getY(), deltaTime);
 
     // 아이템 시스템 업데이트
-    itemManager->update(deltaTime);
+    itemManager->update(deltaTime, player->getX(), player->getY());
     
-    // 플레이어와 아이템 충돌 검사
+    // 플레이어와 아이템 충돌 검사 (효과음은 스냅샷을 받은 메인 스레드가 재생)
     if (itemManager->checkItemCollision(player->getX(), player->getY())) {
+        ++itemsCollected;
+    }
+}
+
+void Game::captureSnapshot(FrameSnapshot& snapshot) {
+    snapshot.playerX = player->getX();
+    snapshot.playerY = player->getY();
+    snapshot.playerAngle = player->getAngle();
+    snapshot.previousPlayerX = previousPlayerX;
+    snapshot.previousPlayerY = previousPlayerY;
+    snapshot.previousPlayerAngle = previousPlayerAngle;
+    snapshot.interpolation = static_cast<float>(simulationAccumulator / SIMULATION_STEP);
+
+    // 렌더러 사거리 안의 아이템/몬스터만 복사한다 (시야 밖은 렌더러가 걸러 낸다)
+    snapshot.sprites.clear();
+    entityGrid->queryRadius(player->getX(), player->getY(), SPRITE_CAPTURE_RADIUS,
+                            SPATIAL_LAYER_ITEM | SPATIAL_LAYER_MONSTER, captureResults);
+    const std::vector<Item>& items = itemManager->getItems();
+    for (int handle : captureResults) {
+        SpriteState sprite;
+        int index = static_cast<int>(entityGrid->getUserData(handle));
+        if (entityGrid->getLayer(handle) == SPATIAL_LAYER_MONSTER) {
+            sprite.x = monsterSystem->getX(index);
+            sprite.y = monsterSystem->getY(index);
+            sprite.previousX = monsterSystem->getPreviousX(index);
+            sprite.previousY = monsterSystem->getPreviousY(index);
+            sprite.lift = 0.0f;
+            sprite.kind = SPRITE_KIND_MONSTER;
+        } else {
+            const Item& item = items[index];
+            sprite.x = sprite.previousX = item.x;
+            sprite.y = sprite.previousY = item.y;
+            // 아이템은 살짝 떠서 위아래로 흔들린다
+            sprite.lift = 0.1f + 0.05f * std::sin(item.animationTime * 3.0f);
+            sprite.kind = static_cast<int8_t>(static_cast<int>(item.type) - 1);
+        }
+        snapshot.sprites.push_back(sprite);
+    }
+
+    snapshot.health = itemManager->getHealth();
+    snapshot.ammo = itemManager->getAmmo();
+    snapshot.hasRedKey = itemManager->hasKey(ItemType::KEY_RED);
+    snapshot.hasBlueKey = itemManager->hasKey(ItemType::KEY_BLUE);
+    snapshot.hasYellowKey = itemManager->hasKey(ItemType::KEY_YELLOW);
+
+    snapshot.playerMoving = isMoving;
+    snapshot.itemsCollected = itemsCollected;
+    itemsCollected = 0;
+    snapshot.monsterCount = monsterSystem->getCount();
+    snapshot.nearestMonsterDistance = monsterSystem->getNearestDistance();
+}
+
+void Game::synchronizeWorld(const FrameSnapshot& snapshot) {
+    // 플레이어 위치에 따라 청크 로드
+    map->checkAndLoadChunks(player->getX(), player->getY(), player->getAngle());
+
+    // 점광원 격자 갱신 (바뀐 광원이나 지형이 있을 때만 다시 계산)
+    updateMonsterLights(snapshot);
+    lightSystem->updatePointLights(map);
+}
+
+void Game::updateMonsterLights(const FrameSnapshot& snapshot) {
+    // 스냅샷에 담긴 (렌더러 사거리 안의) 몬스터 중 가장 가까운 것부터
+    nearestMonsters.clear();
+    for (const SpriteState& sprite : snapshot.sprites) {
+        if (sprite.kind == SPRITE_KIND_MONSTER) nearestMonsters.push_back(&sprite);
+    }
+    auto distanceSquared = [&snapshot](const SpriteState* sprite) {
+        float dx = sprite->x - snapshot.playerX;
+        float dy = sprite->y - snapshot.playerY;
+        return dx * dx + dy * dy;
+    };
+    size_t count = std::min(nearestMonsters.size(), static_cast<size_t>(MONSTER_LIGHT_COUNT));
+    std::partial_sort(nearestMonsters.begin(), nearestMonsters.begin() + count, nearestMonsters.end(),
+                      [&](const SpriteState* a, const SpriteState* b) { return distanceSquared(a) < distanceSquared(b); });
+
+    // 광원 수를 몬스터 수에 맞추고 (빛이 없으면 렌더러가 점광원 처리를 통째로 건너뛴다) 타일 중앙으로 옮긴다
+    while (monsterLights.size() > count) {
+        lightSystem->removePointLight(monsterLights.back());
+        monsterLights.pop_back();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        float x = std::floor(nearestMonsters[i]->x) + 0.5f;
+        float y = std::floor(nearestMonsters[i]->y) + 0.5f;
+        if (i < monsterLights.size()) {
+            lightSystem->movePointLight(monsterLights[i], x, y);
+        } else {
+            monsterLights.push_back(lightSystem->addPointLight(x, y, MONSTER_LIGHT_RADIUS, MONSTER_LIGHT_INTENSITY));
+        }
+    }
+}
+
+void Game::applySnapshot(const FrameSnapshot& snapshot) {
+    if (audioManager && audioManager->isInitialized()) {
+        // 발자국 소리 재생 (재생 간격은 AudioManager가 제한)
+        if (snapshot.playerMoving) {
+            audioManager->playFootstep();
+        }
         // 아이템 수집 효과음
-        if (audioManager && audioManager->isInitialized()) {
+        if (snapshot.itemsCollected > 0) {
             if (audioManager->isSoundLoaded("pickup")) {
                 audioManager->playSound("pickup");
             } else {
                 audioManager->playSound(SoundType::UI_BEEP);
             }
         }
+        if (snapshot.monsterCount > 0) {
+            audioManager->updatePositionalSound("monster", snapshot.nearestMonsterDistance, MonsterSystem::CHASE_RADIUS);
+        }
     }
     
     // HUD 업데이트
     hud->setFPS(currentFPS);
     hud->setFlashlightStatus(lightSystem->isFlashlightEnabled());
-    hud->setHealth(itemManager->getHealth());
-    hud->setAmmo(itemManager->getAmmo());
+    hud->setHealth(snapshot.health);
+    hud->setAmmo(snapshot.ammo);
     
     // 키 보유 현황 업데이트
-    bool hasRedKey = itemManager->hasKey(ItemType::KEY_RED);
-    bool hasBlueKey = itemManager->hasKey(ItemType::KEY_BLUE);
-    bool hasYellowKey = itemManager->hasKey(ItemType::KEY_YELLOW);
-    hud->setKeyStatus(hasRedKey, hasBlueKey, hasYellowKey);
+    hud->setKeyStatus(snapshot.hasRedKey, snapshot.hasBlueKey, snapshot.hasYellowKey);
     
     // 오디오 상태 업데이트
     if (audioManager) {
@@ -277,15 +518,24 @@ void Game::update(float deltaTime) {
     }
 }
 
-void Game::render() {
+void Game::render(const FrameSnapshot& snapshot) {
+    // 직전 스텝과 현재 스텝 사이의 시점에서 본다. 각도는 0/2π 경계를 넘을 때 짧은 쪽으로 보간
+    float interpolation = snapshot.interpolation;
+    float angleDelta = snapshot.playerAngle - snapshot.previousPlayerAngle;
+    if (angleDelta > M_PI) angleDelta -= 2 * M_PI;
+    if (angleDelta < -M_PI) angleDelta += 2 * M_PI;
+    Player view(snapshot.previousPlayerX + (snapshot.playerX - snapshot.previousPlayerX) * interpolation,
+                snapshot.previousPlayerY + (snapshot.playerY - snapshot.previousPlayerY) * interpolation,
+                snapshot.previousPlayerAngle + angleDelta * interpolation);
+
     // 3D 월드를 버퍼에 렌더링
-    gameRenderer->render(player, map, itemManager->getItems(), nullptr);
+    gameRenderer->render(&view, map, snapshot.sprites, interpolation);
 
     // 버퍼를 화면에 복사
     gameRenderer->present();
 
     // 2D UI 요소들을 화면에 직접 렌더링 (3D 월드 위에)
-    gameRenderer->renderMiniMap(player, map);
+    gameRenderer->renderMiniMap(&view, map);
     hud->render();
     
     // 최종 결과물을 화면에 표시
@@ -293,7 +543,15 @@ void Game::render() {
 }
 
 void Game::cleanup() {
+    stopSimulation();
+    if (map) {
+        ChunkStats chunkStats = map->getChunkStats();
+        std::cout << "Chunks: " << chunkStats.resident << " resident, " << chunkStats.evicted << " evicted, "
+                  << chunkStats.regenerated << " regenerated" << std::endl;
+    }
+    delete monsterSystem;
     delete itemManager;
+    delete entityGrid;
     delete hud;
     delete gameRenderer;
     delete lightSystem;
@@ -317,10 +575,11 @@ void Game::cleanup() {
 
 void Game::calculateFPS() {
     frameCount++;
-    Uint32 currentTime = SDL_GetTicks();
+    Uint64 currentTime = SDL_GetPerformanceCounter();
+    double elapsed = static_cast<double>(currentTime - fpsTimer) / SDL_GetPerformanceFrequency();
     
-    if (currentTime - fpsTimer >= 1000) {
-        currentFPS = frameCount * 1000.0f / (currentTime - fpsTimer);
+    if (elapsed >= 1.0) {
+        currentFPS = static_cast<float>(frameCount / elapsed);
         frameCount = 0;
         fpsTimer = currentTime;
     }
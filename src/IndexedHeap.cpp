@@ -0,0 +1,64 @@
+#include "IndexedHeap.h"
+
+void IndexedHeap::reserve(int capacity) {
+    if (capacity > static_cast<int>(position.size())) {
+        position.resize(capacity, -1);
+        items.reserve(capacity);
+    }
+}
+
+void IndexedHeap::clear() {
+    for (const Item& item : items) {
+        position[item.id] = -1;
+    }
+    items.clear();
+}
+
+void IndexedHeap::push(int id, float key) {
+    items.push_back({id, key});
+    position[id] = static_cast<int>(items.size()) - 1;
+    siftUp(static_cast<int>(items.size()) - 1);
+}
+
+void IndexedHeap::decreaseKey(int id, float key) {
+    int index = position[id];
+    items[index].key = key;
+    siftUp(index);
+}
+
+int IndexedHeap::pop() {
+    int id = items[0].id;
+    position[id] = -1;
+    Item last = items.back();
+    items.pop_back();
+    if (!items.empty()) {
+        place(0, last);
+        siftDown(0);
+    }
+    return id;
+}
+
+void IndexedHeap::siftUp(int index) {
+    Item item = items[index];
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (items[parent].key <= item.key) break;
+        place(index, items[parent]);
+        index = parent;
+    }
+    place(index, item);
+}
+
+void IndexedHeap::siftDown(int index) {
+    Item item = items[index];
+    int count = static_cast<int>(items.size());
+    while (true) {
+        int child = index * 2 + 1;
+        if (child >= count) break;
+        if (child + 1 < count && items[child + 1].key < items[child].key) ++child;
+        if (item.key <= items[child].key) break;
+        place(index, items[child]);
+        index = child;
+    }
+    place(index, item);
+}
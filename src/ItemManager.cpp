@@ -1,9 +1,10 @@
 #include "ItemManager.h"
+#include "SpatialGrid.h"
 #include <cmath>
 #include <algorithm>
 
-ItemManager::ItemManager() 
-    : redKeys(0), blueKeys(0), yellowKeys(0), health(100), ammo(50) {
+ItemManager::ItemManager(SpatialGrid* grid)
+    : grid(grid), redKeys(0), blueKeys(0), yellowKeys(0), health(100), ammo(50) {
 }
 
 ItemManager::~ItemManager() {
@@ -11,40 +12,30 @@ ItemManager::~ItemManager() {
 
 void ItemManager::addItem(float x, float y, ItemType type) {
     items.emplace_back(x, y, type);
+    items.back().spatialHandle = grid->insert(x, y, SPATIAL_LAYER_ITEM, static_cast<uint32_t>(items.size() - 1));
 }
 
 void ItemManager::clearItems() {
+    for (const Item& item : items) {
+        grid->remove(item.spatialHandle);
+    }
     items.clear();
 }
 
 bool ItemManager::checkItemCollision(float playerX, float playerY, float radius) {
-    bool collected = false;
-    
-    for (size_t i = 0; i < items.size(); ++i) {
-        Item& item = items[i];
-        if (item.collected) continue;
-        
-        // 거리 계산
-        float dx = item.x - playerX;
-        float dy = item.y - playerY;
-        float distance = sqrt(dx * dx + dy * dy);
-        
-        // 충돌 검사
-        if (distance < radius) {
-            collectItem(i);
-            collected = true;
-        }
+    // 색인에는 수집되지 않은 아이템만 있으므로 결과는 모두 수집 대상
+    grid->queryRadius(playerX, playerY, radius, SPATIAL_LAYER_ITEM, queryResults);
+    for (int handle : queryResults) {
+        collectItem(grid->getUserData(handle));
     }
-    
-    return collected;
+    return !queryResults.empty();
 }
 
-void ItemManager::update(float deltaTime) {
-    // 아이템 애니메이션 업데이트
-    for (Item& item : items) {
-        if (!item.collected) {
-            item.animationTime += deltaTime;
-        }
+void ItemManager::update(float deltaTime, float playerX, float playerY) {
+    // 아이템 애니메이션 업데이트 (화면에 보일 수 있는 거리 안만)
+    grid->queryRadius(playerX, playerY, ANIMATION_RADIUS, SPATIAL_LAYER_ITEM, queryResults);
+    for (int handle : queryResults) {
+        items[grid->getUserData(handle)].animationTime += deltaTime;
     }
 }
 
@@ -72,6 +63,8 @@ void ItemManager::collectItem(size_t index) {
     if (item.collected) return;
     
     item.collected = true;
+    grid->remove(item.spatialHandle);
+    item.spatialHandle = -1;
     
     // 아이템 효과 적용
     switch (item.type) {
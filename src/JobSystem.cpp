@@ -0,0 +1,102 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(int threadCount)
+    : stopping(false), batchFunc(nullptr), batchCount(0), batchGrain(1),
+      batchGeneration(0), nextJob(0), jobsRemaining(0), activeWorkers(0) {
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int JobSystem::resolveThreadCount(int requested) {
+    if (requested > 0) return requested;
+    unsigned int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+void JobSystem::parallelFor(int count, int grain, const std::function<void(int, int)>& func) {
+    if (count <= 0) return;
+    grain = std::max(1, grain);
+    int jobCount = (count + grain - 1) / grain;
+
+    // 워커가 없거나 작업이 하나뿐이면 같은 분할로 호출 스레드에서 바로 실행
+    if (workers.empty() || jobCount <= 1) {
+        for (int begin = 0; begin < count; begin += grain) {
+            func(begin, std::min(count, begin + grain));
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batchFunc = &func;
+        batchCount = count;
+        batchGrain = grain;
+        nextJob.store(0, std::memory_order_relaxed);
+        jobsRemaining = jobCount;
+        ++batchGeneration;
+    }
+    wakeCondition.notify_all();
+
+    // 호출 스레드도 작업에 참여
+    int completed = runJobs(func, count, grain);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    jobsRemaining -= completed;
+    doneCondition.wait(lock, [this] { return jobsRemaining == 0 && activeWorkers == 0; });
+    batchFunc = nullptr;
+}
+
+int JobSystem::runJobs(const std::function<void(int, int)>& func, int count, int grain) {
+    int jobCount = (count + grain - 1) / grain;
+    int completed = 0;
+    while (true) {
+        int job = nextJob.fetch_add(1, std::memory_order_relaxed);
+        if (job >= jobCount) break;
+        int begin = job * grain;
+        func(begin, std::min(count, begin + grain));
+        ++completed;
+    }
+    return completed;
+}
+
+void JobSystem::workerLoop() {
+    unsigned int seenGeneration = 0;
+    while (true) {
+        const std::function<void(int, int)>* func;
+        int count, grain;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || batchGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = batchGeneration;
+            // 이미 끝난 배치에 늦게 깨어난 경우
+            if (!batchFunc) continue;
+            func = batchFunc;
+            count = batchCount;
+            grain = batchGrain;
+            ++activeWorkers;
+        }
+
+        int completed = runJobs(*func, count, grain);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobsRemaining -= completed;
+            --activeWorkers;
+        }
+        doneCondition.notify_one();
+    }
+}
@@ -0,0 +1,196 @@
+#include "LightGrid.h"
+#include "ChunkTable.h"
+#include "Map.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+LightGrid::LightGrid()
+    : activeLights(0), removedSinceUpdate(false), litMinX(0), litMinY(0), litMaxX(-1), litMaxY(-1) {}
+
+int LightGrid::addLight(float x, float y, float radius, float intensity) {
+    int id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<int>(lights.size());
+        lights.emplace_back();
+    }
+    Light& light = lights[id];
+    light.x = x;
+    light.y = y;
+    light.radius = std::clamp(radius, 0.5f, MAX_LIGHT_RADIUS);
+    light.intensity = std::max(0.0f, intensity);
+    light.active = true;
+    light.dirty = true;
+    light.revision = 0;
+    ++activeLights;
+    return id;
+}
+
+void LightGrid::removeLight(int id) {
+    if (id < 0 || id >= static_cast<int>(lights.size()) || !lights[id].active) return;
+    lights[id].active = false;
+    lights[id].splat.clear();
+    freeIds.push_back(id);
+    --activeLights;
+    removedSinceUpdate = true;
+}
+
+void LightGrid::moveLight(int id, float x, float y) {
+    if (id < 0 || id >= static_cast<int>(lights.size()) || !lights[id].active) return;
+    Light& light = lights[id];
+    if (light.x == x && light.y == y) return;
+    light.x = x;
+    light.y = y;
+    light.dirty = true;
+}
+
+void LightGrid::setLightIntensity(int id, float intensity) {
+    if (id < 0 || id >= static_cast<int>(lights.size()) || !lights[id].active) return;
+    Light& light = lights[id];
+    intensity = std::max(0.0f, intensity);
+    if (light.intensity == intensity) return;
+    light.intensity = intensity;
+    light.dirty = true;
+}
+
+uint32_t LightGrid::footprintRevision(const Map* map, const Light& light) const {
+    uint32_t hash = 2166136261u;
+    int minChunkX = static_cast<int>(std::floor(light.x - light.radius)) >> CHUNK_SHIFT;
+    int maxChunkX = static_cast<int>(std::floor(light.x + light.radius)) >> CHUNK_SHIFT;
+    int minChunkY = static_cast<int>(std::floor(light.y - light.radius)) >> CHUNK_SHIFT;
+    int maxChunkY = static_cast<int>(std::floor(light.y + light.radius)) >> CHUNK_SHIFT;
+    for (int chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY) {
+        for (int chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX) {
+            hash = (hash ^ map->getChunkRevision(chunkX, chunkY)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+bool LightGrid::isVisible(const Map* map, float fromX, float fromY, int tileX, int tileY) {
+    // 광원에서 타일 중앙까지 타일 경계를 따라가며 (DDA) 중간 타일이 벽인지 확인
+    int mapX = static_cast<int>(std::floor(fromX));
+    int mapY = static_cast<int>(std::floor(fromY));
+    float dirX = tileX + 0.5f - fromX;
+    float dirY = tileY + 0.5f - fromY;
+
+    float deltaDistX = (dirX == 0.0f) ? 1e30f : std::abs(1.0f / dirX);
+    float deltaDistY = (dirY == 0.0f) ? 1e30f : std::abs(1.0f / dirY);
+    int stepX = dirX < 0 ? -1 : 1;
+    int stepY = dirY < 0 ? -1 : 1;
+    float sideDistX = (dirX < 0 ? fromX - mapX : mapX + 1.0f - fromX) * deltaDistX;
+    float sideDistY = (dirY < 0 ? fromY - mapY : mapY + 1.0f - fromY) * deltaDistY;
+
+    while (mapX != tileX || mapY != tileY) {
+        if (sideDistX < sideDistY) {
+            sideDistX += deltaDistX;
+            mapX += stepX;
+        } else {
+            sideDistY += deltaDistY;
+            mapY += stepY;
+        }
+        if (mapX == tileX && mapY == tileY) break;
+        if (map->getWallType(mapX, mapY) != 0) return false;
+        // 부동소수 오차로 목표를 지나치는 경우 방지 (매개변수 t가 1을 넘으면 도착한 것)
+        if (std::min(sideDistX, sideDistY) > 1.0f + deltaDistX + deltaDistY) break;
+    }
+    return true;
+}
+
+void LightGrid::splatLight(const Map* map, Light& light) {
+    light.originX = static_cast<int>(std::floor(light.x - light.radius));
+    light.originY = static_cast<int>(std::floor(light.y - light.radius));
+    light.size = static_cast<int>(std::floor(light.x + light.radius)) - light.originX + 1;
+    light.size = std::max(light.size, static_cast<int>(std::floor(light.y + light.radius)) - light.originY + 1);
+    light.splat.assign(static_cast<size_t>(light.size) * light.size, 0.0f);
+
+    // 벽 안에 있는 광원은 아무것도 비추지 않는다
+    if (map->getWallType(static_cast<int>(std::floor(light.x)), static_cast<int>(std::floor(light.y))) != 0) return;
+
+    for (int localY = 0; localY < light.size; ++localY) {
+        for (int localX = 0; localX < light.size; ++localX) {
+            int tileX = light.originX + localX;
+            int tileY = light.originY + localY;
+            float dx = tileX + 0.5f - light.x;
+            float dy = tileY + 0.5f - light.y;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance >= light.radius) continue;
+            // 벽 타일은 빛을 담지 않는다. 벽면은 그 앞의 빈 타일 밝기로 그린다
+            if (map->getWallType(tileX, tileY) != 0) continue;
+            if (!isVisible(map, light.x, light.y, tileX, tileY)) continue;
+
+            float falloff = 1.0f - distance / light.radius;
+            light.splat[localY * light.size + localX] = light.intensity * falloff * falloff;
+        }
+    }
+}
+
+void LightGrid::accumulate() {
+    chunkLights.clear();
+    litMinX = litMinY = INT_MAX;
+    litMaxX = litMaxY = INT_MIN;
+
+    for (const Light& light : lights) {
+        if (!light.active) continue;
+        ChunkLight* chunk = nullptr;
+        int chunkX = 0, chunkY = 0;
+        for (int localY = 0; localY < light.size; ++localY) {
+            for (int localX = 0; localX < light.size; ++localX) {
+                float value = light.splat[localY * light.size + localX];
+                if (value <= 0.0f) continue;
+                int tileX = light.originX + localX;
+                int tileY = light.originY + localY;
+                // 같은 청크가 이어지는 동안은 해시 조회를 건너뛴다
+                if (!chunk || (tileX >> CHUNK_SHIFT) != chunkX || (tileY >> CHUNK_SHIFT) != chunkY) {
+                    chunkX = tileX >> CHUNK_SHIFT;
+                    chunkY = tileY >> CHUNK_SHIFT;
+                    auto inserted = chunkLights.try_emplace(ChunkTable::packKey(chunkX, chunkY));
+                    if (inserted.second) std::fill(std::begin(inserted.first->second.levels), std::end(inserted.first->second.levels), 0.0f);
+                    chunk = &inserted.first->second;
+                }
+                chunk->levels[(tileY & CHUNK_MASK) * CHUNK_SIZE + (tileX & CHUNK_MASK)] += value;
+                litMinX = std::min(litMinX, tileX);
+                litMinY = std::min(litMinY, tileY);
+                litMaxX = std::max(litMaxX, tileX);
+                litMaxY = std::max(litMaxY, tileY);
+            }
+        }
+    }
+}
+
+bool LightGrid::update(const Map* map) {
+    bool changed = removedSinceUpdate;
+    removedSinceUpdate = false;
+    for (Light& light : lights) {
+        if (!light.active) continue;
+        uint32_t revision = footprintRevision(map, light);
+        if (light.dirty || revision != light.revision) {
+            splatLight(map, light);
+            light.revision = revision;
+            light.dirty = false;
+            changed = true;
+        }
+    }
+    if (changed) accumulate();
+    return changed;
+}
+
+const float* LightGrid::findChunkLight(int chunkX, int chunkY) const {
+    auto it = chunkLights.find(ChunkTable::packKey(chunkX, chunkY));
+    return it != chunkLights.end() ? it->second.levels : nullptr;
+}
+
+float LightGrid::sample(int tileX, int tileY) const {
+    const float* levels = findChunkLight(tileX >> CHUNK_SHIFT, tileY >> CHUNK_SHIFT);
+    return levels ? levels[(tileY & CHUNK_MASK) * CHUNK_SIZE + (tileX & CHUNK_MASK)] : 0.0f;
+}
+
+void LightGrid::getLitBounds(int& minX, int& minY, int& maxX, int& maxY) const {
+    minX = litMinX;
+    minY = litMinY;
+    maxX = litMaxX;
+    maxY = litMaxY;
+}
@@ -9,7 +9,7 @@ LightSystem::LightSystem()
     : flashlightIntensity(1.2f), flashlightRange(6.0f), 
       flashlightConeAngle(M_PI / 2.0f), ambientLight(0.05f), flashlightEnabled(true),
       lutSize(256) {
-    initializeDistanceLUT();
+    rebuildLUTs();
 }
 
 LightSystem::~LightSystem() {
@@ -29,6 +29,54 @@ void LightSystem::initializeDistanceLUT() {
     }
 }
 
+void LightSystem::initializeConeLUT() {
+    coneLightingLUT.resize(CONE_ANGLE_STEPS * CONE_DISTANCE_STEPS);
+    for (int a = 0; a < CONE_ANGLE_STEPS; ++a) {
+        float angleOffset = static_cast<float>(a) / (CONE_ANGLE_STEPS - 1) * flashlightConeAngle;
+        float cone = flashlightIntensity * calculateDirectionalLight(0.0f, angleOffset, 0.0f);
+        float* row = &coneLightingLUT[a * CONE_DISTANCE_STEPS];
+        for (int d = 0; d < CONE_DISTANCE_STEPS; ++d) {
+            float distance = static_cast<float>(d) / (CONE_DISTANCE_STEPS - 1) * flashlightRange;
+            row[d] = cone * calculateDistanceAttenuation(distance);
+        }
+    }
+}
+
+void LightSystem::rebuildLUTs() {
+    initializeDistanceLUT();
+    initializeConeLUT();
+}
+
+float LightSystem::getConeLight(float angleOffset, float distance) const {
+    // calculateLighting과 같은 기본 환경광
+    float totalLight = ambientLight * 0.001f;
+
+    float normalizedAngle = std::abs(angleOffset) / flashlightConeAngle;
+    if (flashlightEnabled && normalizedAngle <= 1.0f) {
+        float angleIndexFloat = normalizedAngle * (CONE_ANGLE_STEPS - 1);
+        int angleIndex = std::min(static_cast<int>(angleIndexFloat), CONE_ANGLE_STEPS - 2);
+        float angleT = angleIndexFloat - angleIndex;
+        const float* row0 = &coneLightingLUT[angleIndex * CONE_DISTANCE_STEPS];
+        const float* row1 = row0 + CONE_DISTANCE_STEPS;
+
+        if (distance <= flashlightRange) {
+            float distanceIndexFloat = std::max(0.0f, distance) / flashlightRange * (CONE_DISTANCE_STEPS - 1);
+            int distanceIndex = std::min(static_cast<int>(distanceIndexFloat), CONE_DISTANCE_STEPS - 2);
+            float distanceT = distanceIndexFloat - distanceIndex;
+            float lower = row0[distanceIndex] + distanceT * (row0[distanceIndex + 1] - row0[distanceIndex]);
+            float upper = row1[distanceIndex] + distanceT * (row1[distanceIndex + 1] - row1[distanceIndex]);
+            totalLight += lower + angleT * (upper - lower);
+        } else {
+            // 사거리 밖은 감쇠가 1%로 끊기므로 보간하지 않고 거리 0의 원뿔 밝기에서 바로 계산
+            // (calculateDistanceAttenuation과 같은 식, 나눗셈 한 번)
+            float cone = row0[0] + angleT * (row1[0] - row0[0]);
+            totalLight += cone * 0.01f / (1.0f + 0.3f * distance + 0.15f * distance * distance);
+        }
+    }
+
+    return std::clamp(totalLight, 0.0f, 1.0f);
+}
+
 float LightSystem::getLightFromDistanceLUT(float distance) const {
     if (distance >= flashlightRange) {
         return 0.0f;
@@ -56,10 +104,17 @@ void LightSystem::toggleFlashlight() {
 
 void LightSystem::setFlashlightIntensity(float intensity) {
     flashlightIntensity = std::clamp(intensity, 0.0f, 2.0f);
+    rebuildLUTs();
 }
 
 void LightSystem::setFlashlightRange(float range) {
     flashlightRange = std::max(1.0f, range);
+    rebuildLUTs();
+}
+
+void LightSystem::setFlashlightConeAngle(float angle) {
+    flashlightConeAngle = std::clamp(angle, 0.01f, static_cast<float>(M_PI));
+    rebuildLUTs();
 }
 
 void LightSystem::setAmbientLight(float ambient) {
@@ -75,7 +130,7 @@ float LightSystem::calculateLighting(float playerX, float playerY, float playerA
         // 타겟 방향 계산
         float deltaX = targetX - playerX;
         float deltaY = targetY - playerY;
-        float targetAngle = atan2(deltaY, deltaX);
+        float targetAngle = std::atan2(deltaY, deltaX);
         
         // 방향성 조명 계산
         float directionalLight = calculateDirectionalLight(playerAngle, targetAngle, distance);
@@ -110,8 +165,8 @@ float LightSystem::calculateDirectionalLight(float playerAngle, float targetAngl
         float normalizedAngle = angleDiff / flashlightConeAngle;
         
         // 더 극적인 감쇠 커브 (낙하산 형태)
-        float coneIntensity = cos(normalizedAngle * M_PI / 2.0f);
-        coneIntensity = pow(coneIntensity, 4.0f); // 4제곱으로 더욱 극적인 감쇠
+        float coneIntensity = std::cos(normalizedAngle * static_cast<float>(M_PI) / 2.0f);
+        coneIntensity = std::pow(coneIntensity, 4.0f); // 4제곱으로 더욱 극적인 감쇠
         
         return coneIntensity;
     }
@@ -137,7 +192,7 @@ float LightSystem::calculateDistanceAttenuation(float distance) const {
             if (fadeRatio >= 1.0f) {
                 attenuation *= 0.01f;
             } else {
-                attenuation *= std::max(0.01f, pow(1.0f - fadeRatio, 4.0f));
+                attenuation *= std::max(0.01f, std::pow(1.0f - fadeRatio, 4.0f));
             }
         } else if (distance > flashlightRange) {
             attenuation *= 0.01f;
@@ -153,3 +208,23 @@ float LightSystem::calculateDistanceAttenuation(float distance) const {
     
     return attenuation;
 }
+
+int LightSystem::addPointLight(float x, float y, float radius, float intensity) {
+    return pointLights.addLight(x, y, radius, intensity);
+}
+
+void LightSystem::removePointLight(int id) {
+    pointLights.removeLight(id);
+}
+
+void LightSystem::movePointLight(int id, float x, float y) {
+    pointLights.moveLight(id, x, y);
+}
+
+void LightSystem::setPointLightIntensity(int id, float intensity) {
+    pointLights.setLightIntensity(id, intensity);
+}
+
+void LightSystem::updatePointLights(const Map* map) {
+    pointLights.update(map);
+}
@@ -1,65 +1,317 @@
 #include "Map.h"
 #include "MapGenerator.h"
+#include "ChunkStreamer.h"
+#include "RegionStore.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>
 #include <random>
 
-Map::Map() {
-    // Initialize the map generator with a random seed
+// 1이면 다시 로드된 청크가 제거될 때와 같은 내용인지 체크섬으로 확인한다 (cmake -DJOOM_VERIFY_CHUNKS=ON)
+#ifndef JOOM_VERIFY_CHUNKS
+#define JOOM_VERIFY_CHUNKS 0
+#endif
+
+namespace {
+// 플레이어 청크 주변으로 미리 생성해 둘 범위 (청크 단위)
+const int LOAD_RADIUS = 2;
+const int MIN_RESIDENT_CHUNKS = (2 * LOAD_RADIUS + 1) * (2 * LOAD_RADIUS + 1);
+
+// 기본 상주 예산: 1024청크(256KB)
+const int DEFAULT_MAX_RESIDENT_CHUNKS = 1024;
+
+// 모든 Map 인스턴스에서 겹치지 않는 세대 값 (0은 "캐시 비어 있음")
+std::atomic<unsigned int> nextGeneration(1);
+
+// getWallType은 연속된 호출이 대부분 같은 청크를 보므로 마지막으로 찾은 청크를 스레드마다 기억한다
+struct LastChunkCache {
+    unsigned int generation;
+    int chunkX, chunkY;
+    const Chunk* chunk;
+};
+thread_local LastChunkCache lastChunk = {0, 0, 0, nullptr};
+
+unsigned int randomSeed() {
     std::random_device rd;
-    unsigned int seed = rd();
+    return rd();
+}
+}
+
+Map::Map() : Map(randomSeed()) {
+}
+
+Map::Map(unsigned int mapSeed)
+    : seed(mapSeed), maxResidentChunks(DEFAULT_MAX_RESIDENT_CHUNKS), evictRadius(DEFAULT_EVICT_RADIUS),
+      residencyTick(0), lastPlayerChunkX(0), lastPlayerChunkY(0), chunksAdded(false),
+      evictionCounter(0), stats{0, 0, 0, 0, 0, 0, 0}, generation(nextGeneration++), lastRevision(0) {
     std::cout << "MapGenerator seed: " << seed << std::endl;
     mapGenerator = std::make_unique<MapGenerator>(seed);
+    chunkStreamer = std::make_unique<ChunkStreamer>(*mapGenerator);
 }
 
 Map::~Map() {
+    // 저장되지 않은 청크를 모두 기록 (RegionStore 소멸자가 쓰기 완료를 기다린다)
+    if (regionStore) {
+        for (uint64_t key : unsavedChunks) {
+            const Chunk* chunk = chunks.find(ChunkTable::unpackX(key), ChunkTable::unpackY(key));
+            if (chunk) regionStore->queueWrite(ChunkTable::unpackX(key), ChunkTable::unpackY(key), *chunk);
+        }
+    }
+}
+
+bool Map::enablePersistence(const std::string& directory) {
+    auto store = std::make_unique<RegionStore>(directory);
+    if (!store->isOpen()) return false;
+    regionStore = std::move(store);
+    chunkStreamer->setRegionStore(regionStore.get());
+    std::cout << "Chunk store: " << directory << std::endl;
+    return true;
 }
 
 void Map::generateInitialChunk() {
     std::cout << "Generating initial chunk with Perlin noise..." << std::endl;
     // Generate the first chunk at (0,0)
-    chunks[{0, 0}] = mapGenerator->generateChunk(0, 0);
+    generateChunkNow(0, 0);
 }
 
-void Map::checkAndLoadChunks(float playerX, float playerY) {
-    int playerChunkX = floor(playerX / CHUNK_SIZE);
-    int playerChunkY = floor(playerY / CHUNK_SIZE);
-    const int loadRadius = 1; // Load a 3x3 grid of chunks around the player
+long long Map::pregenerate(int minChunkX, int minChunkY, int maxChunkX, int maxChunkY, JobSystem& jobs) {
+    if (!regionStore) return -1;
+    regionStore->flush();
+
+    // 한 번에 리전 하나(1024청크, 256KB)만 메모리에 둔다
+    std::vector<Chunk> regionChunks(REGION_CHUNKS);
+    std::vector<const Chunk*> slots(REGION_CHUNKS);
+    long long written = 0;
+    for (int regionY = minChunkY >> REGION_SHIFT; regionY <= maxChunkY >> REGION_SHIFT; ++regionY) {
+        for (int regionX = minChunkX >> REGION_SHIFT; regionX <= maxChunkX >> REGION_SHIFT; ++regionX) {
+            // 리전과 요청 범위가 겹치는 부분만 생성
+            int beginX = std::max(minChunkX, regionX << REGION_SHIFT);
+            int beginY = std::max(minChunkY, regionY << REGION_SHIFT);
+            int width = std::min(maxChunkX, ((regionX + 1) << REGION_SHIFT) - 1) - beginX + 1;
+            int height = std::min(maxChunkY, ((regionY + 1) << REGION_SHIFT) - 1) - beginY + 1;
+            mapGenerator->generateChunks(beginX, beginY, width, height, regionChunks.data(), jobs);
 
-    for (int y = playerChunkY - loadRadius; y <= playerChunkY + loadRadius; ++y) {
-        for (int x = playerChunkX - loadRadius; x <= playerChunkX + loadRadius; ++x) {
-            if (chunks.find({x, y}) == chunks.end()) {
-                // Chunk is not loaded, so generate it
-                std::cout << "Player is near unloaded area. Generating new chunk at (" << x << ", " << y << ")..." << std::endl;
-                chunks[{x, y}] = mapGenerator->generateChunk(x, y);
+            // 이미 저장된 슬롯은 건드리지 않는다
+            std::fill(slots.begin(), slots.end(), nullptr);
+            Chunk stored;
+            for (int i = 0; i < width * height; ++i) {
+                int chunkX = beginX + i % width;
+                int chunkY = beginY + i / width;
+                if (regionStore->readChunk(chunkX, chunkY, stored)) continue;
+                int index = ((chunkY & (REGION_SIZE - 1)) << REGION_SHIFT) | (chunkX & (REGION_SIZE - 1));
+                slots[index] = &regionChunks[i];
+                ++written;
             }
+            regionStore->writeRegion(regionX, regionY, slots.data());
         }
     }
+    return written;
 }
 
-int Map::getWallType(int x, int y) const {
-    // 1. Calculate chunk coordinates
-    int chunkX = floor(static_cast<float>(x) / CHUNK_SIZE);
-    int chunkY = floor(static_cast<float>(y) / CHUNK_SIZE);
-
-    // 2. Find the chunk
-    auto it = chunks.find({chunkX, chunkY});
-    if (it == chunks.end()) {
-        return 1; // If chunk is not loaded, treat as a solid wall
+void Map::generateChunkNow(int chunkX, int chunkY) {
+    if (chunks.find(chunkX, chunkY)) return;
+    Chunk& chunk = addChunk(chunkX, chunkY);
+    bool fromStore = regionStore && regionStore->readChunk(chunkX, chunkY, chunk);
+    if (!fromStore) {
+        mapGenerator->generateChunk(chunkX, chunkY, chunk);
+    }
+    onChunkLoaded(chunkX, chunkY, chunk, fromStore);
+}
+
+void Map::checkAndLoadChunks(float playerX, float playerY, float playerAngle) {
+    int playerChunkX = static_cast<int>(std::floor(playerX)) >> CHUNK_SHIFT;
+    int playerChunkY = static_cast<int>(std::floor(playerY)) >> CHUNK_SHIFT;
+
+    // 1. Publish chunks the background worker has finished (dropping ones the player already left behind)
+    while (const ChunkStreamer::ReadyChunk* ready = chunkStreamer->peekReady()) {
+        pendingChunks.erase(ChunkTable::packKey(ready->chunkX, ready->chunkY));
+        bool inRange = std::abs(ready->chunkX - playerChunkX) <= evictRadius &&
+                       std::abs(ready->chunkY - playerChunkY) <= evictRadius;
+        if (inRange && !chunks.find(ready->chunkX, ready->chunkY)) {
+            addChunk(ready->chunkX, ready->chunkY) = ready->chunk;
+            onChunkLoaded(ready->chunkX, ready->chunkY, ready->chunk, ready->fromStore);
+        }
+        chunkStreamer->popReady();
     }
 
-    // 3. Calculate tile coordinates within the chunk
-    int tileX = x % CHUNK_SIZE;
-    int tileY = y % CHUNK_SIZE;
-    if (tileX < 0) tileX += CHUNK_SIZE;
-    if (tileY < 0) tileY += CHUNK_SIZE;
+    // 2. Request missing chunks around the player; the worker orders them by distance and heading
+    chunkStreamer->setFocus(playerX / CHUNK_SIZE, playerY / CHUNK_SIZE, std::cos(playerAngle), std::sin(playerAngle));
+
+    ++residencyTick;
+    for (int y = playerChunkY - LOAD_RADIUS; y <= playerChunkY + LOAD_RADIUS; ++y) {
+        for (int x = playerChunkX - LOAD_RADIUS; x <= playerChunkX + LOAD_RADIUS; ++x) {
+            if (chunks.find(x, y)) {
+                chunks.touch(x, y, residencyTick);
+                continue;
+            }
+            if (pendingChunks.insert(ChunkTable::packKey(x, y)).second) {
+                chunkStreamer->request(x, y);
+            }
+        }
+    }
 
-    // 4. Get the tile from the chunk
-    if (tileY >= 0 && tileY < CHUNK_SIZE && tileX >= 0 && tileX < CHUNK_SIZE) {
-        return it->second.tiles[tileY][tileX];
+    // 3. Enforce the residency budget when something could have changed
+    if (chunksAdded || playerChunkX != lastPlayerChunkX || playerChunkY != lastPlayerChunkY) {
+        evictChunks(playerChunkX, playerChunkY);
+        chunksAdded = false;
+        lastPlayerChunkX = playerChunkX;
+        lastPlayerChunkY = playerChunkY;
     }
+}
+
+void Map::evictChunks(int playerChunkX, int playerChunkY) {
+    std::vector<std::pair<uint32_t, uint64_t>> candidates; // (lastUsed, key), 로드 반경 밖의 청크만
+    std::vector<uint64_t> outOfRange;
+    chunks.forEach([&](int chunkX, int chunkY, uint32_t lastUsed) {
+        int distance = std::max(std::abs(chunkX - playerChunkX), std::abs(chunkY - playerChunkY));
+        if (distance > evictRadius) {
+            outOfRange.push_back(ChunkTable::packKey(chunkX, chunkY));
+        } else if (distance > LOAD_RADIUS) {
+            candidates.emplace_back(lastUsed, ChunkTable::packKey(chunkX, chunkY));
+        }
+    });
+
+    for (uint64_t key : outOfRange) {
+        removeChunk(ChunkTable::unpackX(key), ChunkTable::unpackY(key));
+    }
+
+    int excess = chunks.size() - maxResidentChunks;
+    if (excess <= 0) return;
+    excess = std::min(excess, static_cast<int>(candidates.size()));
+    std::partial_sort(candidates.begin(), candidates.begin() + excess, candidates.end());
+    for (int i = 0; i < excess; ++i) {
+        removeChunk(ChunkTable::unpackX(candidates[i].second), ChunkTable::unpackY(candidates[i].second));
+    }
+}
+
+void Map::removeChunk(int chunkX, int chunkY) {
+    const Chunk* chunk = chunks.find(chunkX, chunkY);
+    if (!chunk) return;
+    uint64_t key = ChunkTable::packKey(chunkX, chunkY);
+    rememberEvicted(key, *chunk);
+    bool unsaved = unsavedChunks.erase(key) > 0;
+    if (unsaved && regionStore) {
+        regionStore->queueWrite(chunkX, chunkY, *chunk);
+    }
+    chunks.erase(chunkX, chunkY);
+    generation = nextGeneration++; // 다른 스레드의 마지막 청크 캐시가 제거된 청크를 가리키지 않도록
+    ++stats.evicted;
+}
+
+void Map::rememberEvicted(uint64_t key, const Chunk& chunk) {
+    EvictedChunk& entry = recentlyEvicted[key];
+    entry.order = evictionCounter++;
+#if JOOM_VERIFY_CHUNKS
+    entry.checksum = checksumChunk(chunk);
+#else
+    (void)chunk;
+    entry.checksum = 0;
+#endif
+    evictionOrder.emplace_back(key, entry.order);
+
+    // 최근 maxResidentChunks번의 제거만 기억한다. 그사이 다시 로드되었거나 또 제거된 항목은 맵에서 이미 바뀌어 있다
+    while (static_cast<int>(evictionOrder.size()) > maxResidentChunks) {
+        std::pair<uint64_t, uint32_t> oldest = evictionOrder.front();
+        evictionOrder.pop_front();
+        auto it = recentlyEvicted.find(oldest.first);
+        if (it != recentlyEvicted.end() && it->second.order == oldest.second) recentlyEvicted.erase(it);
+    }
+}
+
+// 최근 제거된 청크가 다시 로드되면 센다 (검증 빌드에서는 내용이 예전과 같은지도 확인)
+void Map::onChunkLoaded(int chunkX, int chunkY, const Chunk& chunk, bool fromStore) {
+    chunksAdded = true;
+    uint64_t key = ChunkTable::packKey(chunkX, chunkY);
+    if (fromStore) {
+        ++stats.loadedFromStore;
+    } else {
+        unsavedChunks.insert(key);
+    }
+
+    auto it = recentlyEvicted.find(key);
+    if (it == recentlyEvicted.end()) return;
+    ++stats.regenerated;
+#if JOOM_VERIFY_CHUNKS
+    if (it->second.checksum != checksumChunk(chunk)) {
+        ++stats.regenerationMismatches;
+        std::cerr << "Regenerated chunk (" << chunkX << ", " << chunkY << ") differs from the evicted copy" << std::endl;
+    }
+#else
+    (void)chunk;
+#endif
+    recentlyEvicted.erase(it);
+}
+
+// FNV-1a
+uint32_t Map::checksumChunk(const Chunk& chunk) {
+    uint32_t hash = 2166136261u;
+    for (const auto& row : chunk.tiles) {
+        for (Tile tile : row) {
+            hash = (hash ^ tile) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+void Map::setResidencyBudget(int maxChunks, int radius) {
+    maxResidentChunks = std::max(maxChunks, MIN_RESIDENT_CHUNKS);
+    evictRadius = std::max(radius, LOAD_RADIUS);
+    chunksAdded = true; // 다음 checkAndLoadChunks에서 새 예산 적용
+}
+
+void Map::setResidencyBudgetBytes(size_t maxBytes, int radius) {
+    setResidencyBudget(static_cast<int>(maxBytes / sizeof(Chunk)), radius);
+}
+
+ChunkStats Map::getChunkStats() const {
+    ChunkStats current = stats;
+    current.resident = chunks.size();
+    current.pending = static_cast<int>(pendingChunks.size());
+    current.written = regionStore ? regionStore->getChunksWritten() : 0;
+    return current;
+}
+
+Chunk& Map::addChunk(int chunkX, int chunkY) {
+    generation = nextGeneration++;
+    Chunk& chunk = chunks.insert(chunkX, chunkY);
+    chunks.setRevision(chunkX, chunkY, ++lastRevision);
+    return chunk;
+}
+
+const Chunk* Map::findChunk(int chunkX, int chunkY) const {
+    return chunks.find(chunkX, chunkY);
+}
+
+int Map::getWallType(int x, int y) const {
+    // 1. Chunk coordinates (arithmetic shift rounds toward -inf, same as floor division)
+    int chunkX = x >> CHUNK_SHIFT;
+    int chunkY = y >> CHUNK_SHIFT;
+
+    // 2. Find the chunk, trying the last chunk this thread looked at first
+    const Chunk* chunk;
+    if (lastChunk.generation == generation && lastChunk.chunkX == chunkX && lastChunk.chunkY == chunkY) {
+        chunk = lastChunk.chunk;
+    } else {
+        chunk = chunks.find(chunkX, chunkY);
+        if (!chunk) {
+            return 1; // If chunk is not loaded, treat as a solid wall
+        }
+        lastChunk = {generation, chunkX, chunkY, chunk};
+    }
+
+    // 3. Get the tile from the chunk
+    return chunk->tiles[y & CHUNK_MASK][x & CHUNK_MASK];
+}
 
-    return 1; // Out of bounds within the chunk, treat as a wall
+bool Map::setWallType(int x, int y, int wallType) {
+    Chunk* chunk = chunks.find(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+    if (!chunk) return false;
+    chunk->tiles[y & CHUNK_MASK][x & CHUNK_MASK] = static_cast<Tile>(wallType);
+    chunks.setRevision(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT, ++lastRevision);
+    unsavedChunks.insert(ChunkTable::packKey(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT));
+    return true;
 }
 
 bool Map::isWallAt(float x, float y) const {
@@ -1,11 +1,35 @@
 #include "MapGenerator.h"
+#include "JobSystem.h"
 
-MapGenerator::MapGenerator(unsigned int seed) : perlin(seed) {
+MapGenerator::MapGenerator(unsigned int seed) : perlin(seed), perlinBatch(perlin.serialize()) {
 }
 
-Chunk MapGenerator::generateChunk(int chunkX, int chunkY) {
-    Chunk newChunk;
+void MapGenerator::generateChunk(int chunkX, int chunkY, Chunk& chunk) const {
+    // 청크 전체의 노이즈를 한 번에 계산 (0.0 ~ 1.0)
+    float noise[CHUNK_SIZE * CHUNK_SIZE];
+    perlinBatch.octave2D_01(chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, frequency, CHUNK_SIZE, CHUNK_SIZE,
+                            octaves, 0.5f, noise);
 
+    const float wallThreshold = static_cast<float>(threshold);
+    for (int y = 0; y < CHUNK_SIZE; ++y) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            // If the noise value is above the threshold, it's a wall.
+            chunk.tiles[y][x] = noise[y * CHUNK_SIZE + x] > wallThreshold ? 1 : 0;
+        }
+    }
+}
+
+void MapGenerator::generateChunks(int firstChunkX, int firstChunkY, int width, int height, Chunk* out,
+                                  JobSystem& jobs) const {
+    const int chunksPerJob = 16;
+    jobs.parallelFor(width * height, chunksPerJob, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            generateChunk(firstChunkX + i % width, firstChunkY + i / width, out[i]);
+        }
+    });
+}
+
+void MapGenerator::generateChunkReference(int chunkX, int chunkY, Chunk& chunk) const {
     for (int y = 0; y < CHUNK_SIZE; ++y) {
         for (int x = 0; x < CHUNK_SIZE; ++x) {
             // Calculate global coordinates for the noise function
@@ -14,16 +38,14 @@ Chunk MapGenerator::generateChunk(int chunkX, int chunkY) {
 
             // Get the 2D Perlin noise value. It's between -1.0 and 1.0.
             // We use octave noise for more detail.
-            double noiseValue = perlin.octave2D_01(globalX * frequency, globalY * frequency, 4);
+            double noiseValue = perlin.octave2D_01(globalX * frequency, globalY * frequency, octaves);
 
             // If the noise value is above the threshold, it's a wall.
             if (noiseValue > threshold) {
-                newChunk.tiles[y][x] = 1; // Wall
+                chunk.tiles[y][x] = 1; // Wall
             } else {
-                newChunk.tiles[y][x] = 0; // Floor
+                chunk.tiles[y][x] = 0; // Floor
             }
         }
     }
-
-    return newChunk;
 }
@@ -0,0 +1,213 @@
+#include "MonsterSystem.h"
+#include "FlowField.h"
+#include "Map.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+const int MAX_SPAWNS_PER_UPDATE = 8;
+const int SPAWN_ATTEMPTS_PER_MONSTER = 4;
+}
+
+// 추격하는 몬스터는 항상 거리 지도 창 안에 있다 (그래서 개별 경로 탐색이 필요 없다)
+static_assert(MonsterSystem::CHASE_RADIUS < FlowField::FIELD_RADIUS, "chase radius must fit in the flow field");
+
+MonsterSystem::MonsterSystem(SpatialGrid* grid, unsigned int seed)
+    : grid(grid), flowField(std::make_unique<FlowField>()),
+      rng(seed), frame(0), levelOfDetail(true), nearestDistance(1e30f), lastTickCount(0) {}
+
+MonsterSystem::~MonsterSystem() {
+    clear();
+}
+
+int MonsterSystem::spawn(float x, float y) {
+    int index = getCount();
+    posX.push_back(x);
+    posY.push_back(y);
+    prevX.push_back(x);
+    prevY.push_back(y);
+    tickFrame.push_back(frame);
+    velX.push_back(0.0f);
+    velY.push_back(0.0f);
+    state.push_back(MonsterState::IDLE);
+    distanceSquared.push_back(0.0f);
+    pendingTime.push_back(0.0f);
+    wanderTimer.push_back(0.0f);
+    spatialHandle.push_back(grid ? grid->insert(x, y, SPATIAL_LAYER_MONSTER, static_cast<uint32_t>(index)) : -1);
+    return index;
+}
+
+void MonsterSystem::despawn(int index) {
+    if (index < 0 || index >= getCount()) return;
+    if (grid) grid->remove(spatialHandle[index]);
+
+    // 마지막 몬스터를 빈 자리로 옮긴다
+    int last = getCount() - 1;
+    if (index != last) {
+        posX[index] = posX[last];
+        posY[index] = posY[last];
+        prevX[index] = prevX[last];
+        prevY[index] = prevY[last];
+        tickFrame[index] = tickFrame[last];
+        velX[index] = velX[last];
+        velY[index] = velY[last];
+        state[index] = state[last];
+        distanceSquared[index] = distanceSquared[last];
+        pendingTime[index] = pendingTime[last];
+        wanderTimer[index] = wanderTimer[last];
+        spatialHandle[index] = spatialHandle[last];
+        if (grid) grid->setUserData(spatialHandle[index], static_cast<uint32_t>(index));
+    }
+    posX.pop_back();
+    posY.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    tickFrame.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    state.pop_back();
+    distanceSquared.pop_back();
+    pendingTime.pop_back();
+    wanderTimer.pop_back();
+    spatialHandle.pop_back();
+}
+
+void MonsterSystem::clear() {
+    while (getCount() > 0) despawn(getCount() - 1);
+}
+
+void MonsterSystem::populate(const Map* map, float playerX, float playerY, int targetCount) {
+    // 역순으로 돌면 맞바꿔 온 몬스터를 다시 검사할 필요가 없다
+    float despawnSquared = DESPAWN_DISTANCE * DESPAWN_DISTANCE;
+    for (int i = getCount() - 1; i >= 0; --i) {
+        float dx = posX[i] - playerX;
+        float dy = posY[i] - playerY;
+        if (dx * dx + dy * dy > despawnSquared) despawn(i);
+    }
+
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> distance(SPAWN_MIN_DISTANCE, SPAWN_MAX_DISTANCE);
+    int spawns = 0;
+    int attempts = 0;
+    while (getCount() < targetCount && spawns < MAX_SPAWNS_PER_UPDATE &&
+           attempts < MAX_SPAWNS_PER_UPDATE * SPAWN_ATTEMPTS_PER_MONSTER) {
+        ++attempts;
+        float a = angle(rng);
+        float d = distance(rng);
+        // 타일 중앙에 놓는다. 로드되지 않은 청크는 벽으로 취급되므로 자연스럽게 제외된다
+        float x = std::floor(playerX + std::cos(a) * d) + 0.5f;
+        float y = std::floor(playerY + std::sin(a) * d) + 0.5f;
+        if (map->isWallAt(x, y)) continue;
+        spawn(x, y);
+        ++spawns;
+    }
+}
+
+void MonsterSystem::update(const Map* map, float playerX, float playerY, float deltaTime) {
+    ++frame;
+    int count = getCount();
+
+    // 1) 플레이어까지 거리 (연속 배열을 한 번에 훑는다)
+    float chaseSquared = CHASE_RADIUS * CHASE_RADIUS;
+    float nearestSquared = 1e30f;
+    bool anyChasing = false;
+    for (int i = 0; i < count; ++i) {
+        float dx = posX[i] - playerX;
+        float dy = posY[i] - playerY;
+        distanceSquared[i] = dx * dx + dy * dy;
+        nearestSquared = std::min(nearestSquared, distanceSquared[i]);
+        anyChasing |= distanceSquared[i] < chaseSquared;
+    }
+    nearestDistance = std::sqrt(nearestSquared);
+
+    // 2) 추격하는 몬스터가 있을 때만 거리 지도를 갱신 (플레이어 타일이나 지형이 바뀌었을 때만 다시 계산됨)
+    if (anyChasing) flowField->update(map, playerX, playerY);
+
+    // 3) 이번 프레임 차례인 몬스터만 생각하고 움직인다
+    float fullSquared = LOD_FULL_DISTANCE * LOD_FULL_DISTANCE;
+    float midSquared = LOD_MID_DISTANCE * LOD_MID_DISTANCE;
+    int ticks = 0;
+    for (int i = 0; i < count; ++i) {
+        pendingTime[i] += deltaTime;
+        if (levelOfDetail && distanceSquared[i] >= fullSquared) {
+            // 인덱스로 차례를 나눠 같은 단계의 몬스터가 한 프레임에 몰리지 않게 한다
+            uint32_t interval = distanceSquared[i] < midSquared ? LOD_MID_INTERVAL : LOD_FAR_INTERVAL;
+            if (((frame + static_cast<uint32_t>(i)) & (interval - 1)) != 0) continue;
+        }
+
+        float elapsed = pendingTime[i];
+        pendingTime[i] = 0.0f;
+        think(i, playerX, playerY, elapsed);
+        // 이번에 움직이는 몬스터만 보간용 이전 위치를 남긴다 (LOD로 건너뛴 몬스터는 복사하지 않음)
+        prevX[i] = posX[i];
+        prevY[i] = posY[i];
+        tickFrame[i] = frame;
+        integrate(i, map, elapsed);
+        ++ticks;
+    }
+    lastTickCount = ticks;
+}
+
+void MonsterSystem::think(int index, float playerX, float playerY, float deltaTime) {
+    float distSquared = distanceSquared[index];
+
+    if (distSquared < ATTACK_RADIUS * ATTACK_RADIUS) {
+        state[index] = MonsterState::ATTACKING;
+        velX[index] = velY[index] = 0.0f;
+        return;
+    }
+
+    if (distSquared >= CHASE_RADIUS * CHASE_RADIUS) {
+        if (state[index] != MonsterState::IDLE) {
+            state[index] = MonsterState::IDLE;
+            wanderTimer[index] = 0.0f;
+        }
+        // 가끔 방향을 바꾸며 천천히 배회 (세 번에 한 번은 멈춰 선다)
+        wanderTimer[index] -= deltaTime;
+        if (wanderTimer[index] <= 0.0f) {
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            float a = unit(rng) * 6.2831853f;
+            float speed = unit(rng) < 0.33f ? 0.0f : WANDER_SPEED;
+            velX[index] = std::cos(a) * speed;
+            velY[index] = std::sin(a) * speed;
+            wanderTimer[index] = 1.0f + unit(rng) * 2.0f;
+        }
+        return;
+    }
+
+    state[index] = MonsterState::CHASING;
+
+    // 공유 거리 지도가 이 타일을 덮고 있으면 가장 가파르게 내려가는 방향으로.
+    // 방향이 없으면 (플레이어와 같은 타일이거나 벽으로 막혀 도달할 수 없음) 플레이어를 직접 향한다
+    float dirX, dirY;
+    if (!flowField->getDirection(posX[index], posY[index], dirX, dirY)) {
+        float dx = playerX - posX[index];
+        float dy = playerY - posY[index];
+        float length = std::sqrt(dx * dx + dy * dy);
+        if (length < 0.01f) {
+            velX[index] = velY[index] = 0.0f;
+            return;
+        }
+        dirX = dx / length;
+        dirY = dy / length;
+    }
+    velX[index] = dirX * CHASE_SPEED;
+    velY[index] = dirY * CHASE_SPEED;
+}
+
+void MonsterSystem::integrate(int index, const Map* map, float deltaTime) {
+    if (velX[index] == 0.0f && velY[index] == 0.0f) return;
+
+    // 축마다 따로 움직여 벽을 따라 미끄러지게 한다. 배회 중 벽에 막히면 다음 차례에 방향을 바꾼다
+    float nextX = posX[index] + velX[index] * deltaTime;
+    float nextY = posY[index] + velY[index] * deltaTime;
+    bool blocked = false;
+    if (!map->isWallAt(nextX, posY[index])) posX[index] = nextX;
+    else blocked = true;
+    if (!map->isWallAt(posX[index], nextY)) posY[index] = nextY;
+    else blocked = true;
+    if (blocked && state[index] == MonsterState::IDLE) wanderTimer[index] = 0.0f;
+
+    if (grid) grid->move(spatialHandle[index], posX[index], posY[index]);
+}
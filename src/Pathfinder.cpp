@@ -1,114 +1,306 @@
 #include "Pathfinder.h"
+#include "ChunkGraph.h"
 #include "Map.h"
-#include <iostream>
+#include <algorithm>
+#include <cmath>
 
-// 우선순위 큐에서 사용할 비교 구조체
-struct CompareNode {
-    bool operator()(const Node* a, const Node* b) const {
-        return a->fCost > b->fCost;
-    }
-};
+namespace {
+const float STRAIGHT_COST = 1.0f;
+const float DIAGONAL_COST = 1.41421356f;
+
+const int NEIGHBOR_DX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+const int NEIGHBOR_DY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+inline bool isBlocked(const Map* map, int x, int y) {
+    return map->getWallType(x, y) != 0;
+}
 
-Pathfinder::Pathfinder() {}
+inline int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+}
+
+Pathfinder::Pathfinder()
+    : strategy(PathStrategy::AStar), lastExpansions(0), chunkGraph(std::make_unique<ChunkGraph>()),
+      originX(0), originY(0), windowWidth(0), windowHeight(0), generation(0) {}
 
 Pathfinder::~Pathfinder() {}
 
-std::vector<Node*> Pathfinder::findPath(int startX, int startY, int endX, int endY, Map* map) {
+void Pathfinder::prepareScratch(int cellCount) {
+    if (cellCount > static_cast<int>(gCost.size())) {
+        gCost.resize(cellCount);
+        parent.resize(cellCount);
+        stamp.resize(cellCount, 0);
+        closed.resize(cellCount);
+        openSet.reserve(cellCount);
+    }
+    openSet.clear();
+    if (++generation == 0) {
+        // 세대 번호가 한 바퀴 돌면 오래된 stamp와 겹치지 않도록 초기화
+        std::fill(stamp.begin(), stamp.end(), 0);
+        generation = 1;
+    }
+}
+
+bool Pathfinder::findPath(int startX, int startY, int endX, int endY, const Map* map, std::vector<PathPoint>& path) {
+    path.clear();
+    lastExpansions = 0;
+
     // 시작점과 끝점이 벽이면 빈 경로 반환
-    if (map->isWall(startX, startY) || map->isWall(endX, endY)) {
-        return {};
+    if (isBlocked(map, startX, startY) || isBlocked(map, endX, endY)) {
+        return false;
     }
 
-    // 열린 목록(방문할 노드)과 닫힌 목록(방문한 노드)
-    std::priority_queue<Node*, std::vector<Node*>, CompareNode> openList;
-    std::map<int, Node*> allNodes; // 모든 생성된 노드를 관리하여 메모리 해제
+    // 가까우면 두 점을 감싸는 탐색 창 안에서 바로 탐색
+    if (std::max(std::abs(endX - startX), std::abs(endY - startY)) <= HIERARCHICAL_DISTANCE) {
+        return findPathInWindow(startX, startY, endX, endY,
+                                std::min(startX, endX) - SEARCH_MARGIN, std::min(startY, endY) - SEARCH_MARGIN,
+                                std::max(startX, endX) + SEARCH_MARGIN, std::max(startY, endY) + SEARCH_MARGIN,
+                                map, path, true);
+    }
 
-    Node* startNode = new Node(startX, startY);
-    startNode->hCost = calculateHeuristic(startX, startY, endX, endY);
-    startNode->fCost = startNode->gCost + startNode->hCost;
-    
-    openList.push(startNode);
-    allNodes[startY * map->getWidth() + startX] = startNode;
+    // 멀면 청크 그래프에서 진입점 경로를 찾고, 구간마다 그 청크 안에서만 세밀한 경로로 바꾼다
+    if (!chunkGraph->findAbstractPath(startX, startY, endX, endY, map, waypoints)) {
+        return false;
+    }
+    path.push_back(waypoints[0]);
+    for (size_t i = 1; i < waypoints.size(); ++i) {
+        const PathPoint& from = waypoints[i - 1];
+        const PathPoint& to = waypoints[i];
+        // 청크 경계를 넘는 간선은 바로 옆 칸
+        if (std::abs(to.x - from.x) <= 1 && std::abs(to.y - from.y) <= 1) {
+            path.push_back(to);
+            continue;
+        }
+        int chunkMinX = (from.x >> CHUNK_SHIFT) * CHUNK_SIZE;
+        int chunkMinY = (from.y >> CHUNK_SHIFT) * CHUNK_SIZE;
+        if (!findPathInWindow(from.x, from.y, to.x, to.y, chunkMinX, chunkMinY,
+                              chunkMinX + CHUNK_SIZE - 1, chunkMinY + CHUNK_SIZE - 1, map, path, false)) {
+            path.clear();
+            return false;
+        }
+    }
+    return true;
+}
 
-    std::vector<Node*> path;
+bool Pathfinder::findPathInWindow(int startX, int startY, int endX, int endY, int minX, int minY, int maxX, int maxY,
+                                  const Map* map, std::vector<PathPoint>& path, bool includeStart) {
+    originX = minX;
+    originY = minY;
+    windowWidth = maxX - minX + 1;
+    windowHeight = maxY - minY + 1;
+    if (windowWidth > MAX_SEARCH_WINDOW || windowHeight > MAX_SEARCH_WINDOW) {
+        return false;
+    }
+    prepareScratch(windowWidth * windowHeight);
+    if (strategy == PathStrategy::JumpPoint) loadWindowTiles(map);
 
-    while (!openList.empty()) {
-        Node* currentNode = openList.top();
-        openList.pop();
+    int startCell = (startY - originY) * windowWidth + (startX - originX);
+    int endCell = (endY - originY) * windowWidth + (endX - originX);
 
-        // 목적지에 도달한 경우
-        if (currentNode->x == endX && currentNode->y == endY) {
-            path = reconstructPath(currentNode);
+    gCost[startCell] = 0.0f;
+    parent[startCell] = -1;
+    stamp[startCell] = generation;
+    closed[startCell] = 0;
+    openSet.push(startCell, calculateHeuristic(startX, startY, endX, endY));
+
+    bool found = false;
+    while (!openSet.empty()) {
+        int current = openSet.pop();
+        ++lastExpansions;
+        if (current == endCell) {
+            found = true;
             break;
         }
+        closed[current] = 1;
+        if (strategy == PathStrategy::JumpPoint) {
+            expandJumpPoint(current, endX, endY);
+        } else {
+            expandAStar(current, endX, endY, map);
+        }
+    }
 
-        // 8방향 이웃 노드 탐색 (상하좌우 + 대각선)
-        for (int dx = -1; dx <= 1; ++dx) {
-            for (int dy = -1; dy <= 1; ++dy) {
-                if (dx == 0 && dy == 0) continue;
-
-                int neighborX = currentNode->x + dx;
-                int neighborY = currentNode->y + dy;
-
-                // 맵 범위를 벗어나거나 벽인 경우 무시
-                if (neighborX < 0 || neighborX >= map->getWidth() || neighborY < 0 || neighborY >= map->getHeight() || map->isWall(neighborX, neighborY)) {
-                    continue;
-                }
-                
-                // 대각선 이동 시, 양 옆이 벽으로 막혀있으면 통과하지 못하도록 처리
-                if (std::abs(dx) == 1 && std::abs(dy) == 1) {
-                    if (map->isWall(currentNode->x + dx, currentNode->y) || map->isWall(currentNode->x, currentNode->y + dy)) {
-                        continue;
-                    }
-                }
-
-                float moveCost = (dx == 0 || dy == 0) ? 1.0f : 1.414f; // 직선 1, 대각선 sqrt(2)
-                float newGCost = currentNode->gCost + moveCost;
-
-                Node* neighborNode = nullptr;
-                int neighborIndex = neighborY * map->getWidth() + neighborX;
-
-                if (allNodes.find(neighborIndex) == allNodes.end() || newGCost < allNodes[neighborIndex]->gCost) {
-                    if (allNodes.find(neighborIndex) != allNodes.end()) {
-                        neighborNode = allNodes[neighborIndex];
-                    } else {
-                        neighborNode = new Node(neighborX, neighborY, currentNode);
-                        allNodes[neighborIndex] = neighborNode;
-                    }
-                    
-                    neighborNode->parent = currentNode;
-                    neighborNode->gCost = newGCost;
-                    neighborNode->hCost = calculateHeuristic(neighborX, neighborY, endX, endY);
-                    neighborNode->fCost = neighborNode->gCost + neighborNode->hCost;
-                    
-                    openList.push(neighborNode);
-                }
-            }
+    if (!found) return false;
+
+    // 경로를 역추적한 뒤 뒤집는다. JPS의 부모는 직선이나 대각선 위의 먼 칸이므로 사이 칸을 채운다
+    size_t first = path.size();
+    for (int cell = endCell; cell != -1; cell = parent[cell]) {
+        int cellX = originX + cell % windowWidth;
+        int cellY = originY + cell / windowWidth;
+        if (parent[cell] == -1) {
+            if (includeStart) path.push_back({cellX, cellY});
+            break;
+        }
+        int parentX = originX + parent[cell] % windowWidth;
+        int parentY = originY + parent[cell] / windowWidth;
+        int stepX = sign(parentX - cellX);
+        int stepY = sign(parentY - cellY);
+        for (int x = cellX, y = cellY; x != parentX || y != parentY; x += stepX, y += stepY) {
+            path.push_back({x, y});
         }
     }
+    std::reverse(path.begin() + first, path.end());
+    return true;
+}
+
+void Pathfinder::relaxCell(int current, int neighbor, float cost, int neighborX, int neighborY, int endX, int endY) {
+    if (stamp[neighbor] == generation && closed[neighbor]) return;
 
-    // 메모리 정리
-    for (auto const& [key, val] : allNodes) {
-        if (std::find(path.begin(), path.end(), val) == path.end()) {
-            delete val;
+    float newGCost = gCost[current] + cost;
+    if (stamp[neighbor] != generation) {
+        stamp[neighbor] = generation;
+        closed[neighbor] = 0;
+        gCost[neighbor] = newGCost;
+        parent[neighbor] = current;
+        openSet.push(neighbor, newGCost + calculateHeuristic(neighborX, neighborY, endX, endY));
+    } else if (newGCost < gCost[neighbor]) {
+        gCost[neighbor] = newGCost;
+        parent[neighbor] = current;
+        openSet.decreaseKey(neighbor, newGCost + calculateHeuristic(neighborX, neighborY, endX, endY));
+    }
+}
+
+void Pathfinder::expandAStar(int current, int endX, int endY, const Map* map) {
+    int localX = current % windowWidth;
+    int localY = current / windowWidth;
+    int currentX = originX + localX;
+    int currentY = originY + localY;
+
+    // 8방향 이웃 노드 탐색 (상하좌우 + 대각선)
+    for (int direction = 0; direction < 8; ++direction) {
+        int dx = NEIGHBOR_DX[direction];
+        int dy = NEIGHBOR_DY[direction];
+        int nextLocalX = localX + dx;
+        int nextLocalY = localY + dy;
+
+        // 탐색 창을 벗어나거나 벽인 경우 무시
+        if (nextLocalX < 0 || nextLocalX >= windowWidth || nextLocalY < 0 || nextLocalY >= windowHeight) continue;
+        int neighbor = nextLocalY * windowWidth + nextLocalX;
+        if (stamp[neighbor] == generation && closed[neighbor]) continue;
+        if (isBlocked(map, currentX + dx, currentY + dy)) continue;
+
+        // 대각선 이동 시, 양 옆이 벽으로 막혀있으면 통과하지 못하도록 처리
+        if (dx != 0 && dy != 0) {
+            if (isBlocked(map, currentX + dx, currentY) || isBlocked(map, currentX, currentY + dy)) continue;
+        }
+
+        relaxCell(current, neighbor, dx == 0 || dy == 0 ? STRAIGHT_COST : DIAGONAL_COST,
+                  currentX + dx, currentY + dy, endX, endY);
+    }
+}
+
+void Pathfinder::loadWindowTiles(const Map* map) {
+    int cellCount = windowWidth * windowHeight;
+    if (cellCount > static_cast<int>(blocked.size())) blocked.resize(cellCount);
+
+    for (int localY = 0; localY < windowHeight; ++localY) {
+        int y = originY + localY;
+        uint8_t* row = &blocked[localY * windowWidth];
+        for (int localX = 0; localX < windowWidth;) {
+            int x = originX + localX;
+            int span = std::min(CHUNK_SIZE - (x & CHUNK_MASK), windowWidth - localX);
+            const Chunk* chunk = map->findChunk(x >> CHUNK_SHIFT, y >> CHUNK_SHIFT);
+            for (int i = 0; i < span; ++i) {
+                // 로드되지 않은 청크는 벽 (getWallType과 같은 규칙)
+                row[localX + i] = chunk ? chunk->tiles[y & CHUNK_MASK][(x & CHUNK_MASK) + i] != 0 : 1;
+            }
+            localX += span;
         }
     }
+}
 
-    return path;
+bool Pathfinder::isWalkable(int x, int y) const {
+    // 탐색 창 밖은 벽으로 취급 (A*와 같은 탐색 공간)
+    int localX = x - originX;
+    int localY = y - originY;
+    if (localX < 0 || localX >= windowWidth || localY < 0 || localY >= windowHeight) return false;
+    return !blocked[localY * windowWidth + localX];
 }
 
-float Pathfinder::calculateHeuristic(int x1, int y1, int x2, int y2) {
-    // 유클리드 거리 사용
-    return std::sqrt(std::pow(x1 - x2, 2) + std::pow(y1 - y2, 2));
+bool Pathfinder::jump(int x, int y, int dx, int dy, int endX, int endY, int& jumpX, int& jumpY) const {
+    while (true) {
+        // 대각선은 양 옆이 모두 열려 있어야 한 칸 나아갈 수 있다
+        if (!isWalkable(x + dx, y + dy)) return false;
+        if (dx != 0 && dy != 0 && (!isWalkable(x + dx, y) || !isWalkable(x, y + dy))) return false;
+        x += dx;
+        y += dy;
+
+        if (x == endX && y == endY) break;
+
+        if (dx != 0 && dy != 0) {
+            // 대각선: 가로나 세로로 뻗은 직선에서 점프 지점이 나오면 여기서 멈춘다
+            int unusedX, unusedY;
+            if (jump(x, y, dx, 0, endX, endY, unusedX, unusedY) ||
+                jump(x, y, 0, dy, endX, endY, unusedX, unusedY)) {
+                break;
+            }
+        } else if (dx != 0) {
+            // 가로: 뒤쪽 옆 칸이 막혀 있으면 옆 칸은 여기를 거쳐야만 갈 수 있다 (강제 이웃)
+            if ((isWalkable(x, y - 1) && !isWalkable(x - dx, y - 1)) ||
+                (isWalkable(x, y + 1) && !isWalkable(x - dx, y + 1))) {
+                break;
+            }
+        } else {
+            if ((isWalkable(x - 1, y) && !isWalkable(x - 1, y - dy)) ||
+                (isWalkable(x + 1, y) && !isWalkable(x + 1, y - dy))) {
+                break;
+            }
+        }
+    }
+    jumpX = x;
+    jumpY = y;
+    return true;
 }
 
-std::vector<Node*> Pathfinder::reconstructPath(Node* endNode) {
-    std::vector<Node*> path;
-    Node* currentNode = endNode;
-    while (currentNode != nullptr) {
-        path.push_back(currentNode);
-        currentNode = currentNode->parent;
+void Pathfinder::expandJumpPoint(int current, int endX, int endY) {
+    int currentX = originX + current % windowWidth;
+    int currentY = originY + current / windowWidth;
+
+    // 진행 방향에 따라 가지치기한 이웃 방향 (시작점은 8방향 모두)
+    int directions[8][2];
+    int directionCount = 0;
+    auto addDirection = [&](int dx, int dy) {
+        directions[directionCount][0] = dx;
+        directions[directionCount][1] = dy;
+        ++directionCount;
+    };
+    if (parent[current] == -1) {
+        for (int direction = 0; direction < 8; ++direction) addDirection(NEIGHBOR_DX[direction], NEIGHBOR_DY[direction]);
+    } else {
+        int dx = sign(currentX - (originX + parent[current] % windowWidth));
+        int dy = sign(currentY - (originY + parent[current] / windowWidth));
+        if (dx != 0 && dy != 0) {
+            // 모서리를 자를 수 없으므로 대각선 진행에는 강제 이웃이 없다
+            addDirection(dx, 0);
+            addDirection(0, dy);
+            addDirection(dx, dy);
+        } else if (dx != 0) {
+            addDirection(dx, 0);
+            addDirection(dx, 1);
+            addDirection(dx, -1);
+            addDirection(0, 1);
+            addDirection(0, -1);
+        } else {
+            addDirection(0, dy);
+            addDirection(1, dy);
+            addDirection(-1, dy);
+            addDirection(1, 0);
+            addDirection(-1, 0);
+        }
+    }
+
+    for (int i = 0; i < directionCount; ++i) {
+        int jumpX, jumpY;
+        if (!jump(currentX, currentY, directions[i][0], directions[i][1], endX, endY, jumpX, jumpY)) continue;
+        int neighbor = (jumpY - originY) * windowWidth + (jumpX - originX);
+        // 점프 구간은 직선 또는 대각선이므로 옥타일 거리가 곧 실제 비용
+        relaxCell(current, neighbor, calculateHeuristic(currentX, currentY, jumpX, jumpY), jumpX, jumpY, endX, endY);
     }
-    std::reverse(path.begin(), path.end());
-    return path;
+}
+
+float Pathfinder::calculateHeuristic(int x1, int y1, int x2, int y2) {
+    // 옥타일 거리: 8방향 이동 비용과 일치하므로 과대평가하지 않는다
+    float dx = static_cast<float>(std::abs(x1 - x2));
+    float dy = static_cast<float>(std::abs(y1 - y2));
+    return STRAIGHT_COST * (dx + dy) + (DIAGONAL_COST - 2.0f * STRAIGHT_COST) * std::min(dx, dy);
 }
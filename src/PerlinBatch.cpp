@@ -0,0 +1,204 @@
+#include "PerlinBatch.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JOOM_PERLIN_SSE2 1
+#include <emmintrin.h>
+#else
+#define JOOM_PERLIN_SSE2 0
+#endif
+
+namespace {
+
+inline float fade(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+// siv::perlin_detail::Grad(hash, x, y, z)를 기울기 벡터로 표현
+void gradientFor(uint8_t hash, float& gx, float& gy, float& gz) {
+    int h = hash & 15;
+    gx = gy = gz = 0.0f;
+    float* u = h < 8 ? &gx : &gy;
+    float* v = h < 4 ? &gy : (h == 12 || h == 14) ? &gx : &gz;
+    *u += (h & 1) == 0 ? 1.0f : -1.0f;
+    *v += (h & 2) == 0 ? 1.0f : -1.0f;
+}
+
+// 한 옥타브, 한 행에서 열별로 펼친 값들 (SoA)
+struct RowCorners {
+    alignas(16) float gx00[PerlinBatch::MAX_WIDTH], gy00[PerlinBatch::MAX_WIDTH], c00[PerlinBatch::MAX_WIDTH];
+    alignas(16) float gx10[PerlinBatch::MAX_WIDTH], gy10[PerlinBatch::MAX_WIDTH], c10[PerlinBatch::MAX_WIDTH];
+    alignas(16) float gx01[PerlinBatch::MAX_WIDTH], gy01[PerlinBatch::MAX_WIDTH], c01[PerlinBatch::MAX_WIDTH];
+    alignas(16) float gx11[PerlinBatch::MAX_WIDTH], gy11[PerlinBatch::MAX_WIDTH], c11[PerlinBatch::MAX_WIDTH];
+};
+
+struct Columns {
+    alignas(16) float fx[PerlinBatch::MAX_WIDTH];
+    alignas(16) float u[PerlinBatch::MAX_WIDTH];
+    int cell[PerlinBatch::MAX_WIDTH]; // 첫 열의 격자 x를 0으로 한 상대 위치
+};
+
+inline float lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+void accumulateScalar(const Columns& cols, const RowCorners& rc, float fy, float v, float amplitude,
+                      int begin, int end, float* out) {
+    float fy1 = fy - 1.0f;
+    for (int i = begin; i < end; ++i) {
+        float fx = cols.fx[i];
+        float fx1 = fx - 1.0f;
+        float n00 = rc.gx00[i] * fx + rc.gy00[i] * fy + rc.c00[i];
+        float n10 = rc.gx10[i] * fx1 + rc.gy10[i] * fy + rc.c10[i];
+        float n01 = rc.gx01[i] * fx + rc.gy01[i] * fy1 + rc.c01[i];
+        float n11 = rc.gx11[i] * fx1 + rc.gy11[i] * fy1 + rc.c11[i];
+        float x0 = lerp(n00, n10, cols.u[i]);
+        float x1 = lerp(n01, n11, cols.u[i]);
+        out[i] += lerp(x0, x1, v) * amplitude;
+    }
+}
+
+#if JOOM_PERLIN_SSE2
+inline __m128 lerpSSE2(__m128 a, __m128 b, __m128 t) {
+    return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t));
+}
+
+inline __m128 dotSSE2(const float* gx, const float* gy, const float* c, int i, __m128 dx, __m128 dy) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(gx + i), dx), _mm_mul_ps(_mm_load_ps(gy + i), dy)),
+                      _mm_load_ps(c + i));
+}
+
+// accumulateScalar와 같은 연산 순서 (결과 동일)
+int accumulateSSE2(const Columns& cols, const RowCorners& rc, float fy, float v, float amplitude,
+                   int count, float* out) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 fy4 = _mm_set1_ps(fy);
+    const __m128 fy1 = _mm_set1_ps(fy - 1.0f);
+    const __m128 v4 = _mm_set1_ps(v);
+    const __m128 amp4 = _mm_set1_ps(amplitude);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 fx = _mm_load_ps(cols.fx + i);
+        __m128 fx1 = _mm_sub_ps(fx, one);
+        __m128 u = _mm_load_ps(cols.u + i);
+        __m128 n00 = dotSSE2(rc.gx00, rc.gy00, rc.c00, i, fx, fy4);
+        __m128 n10 = dotSSE2(rc.gx10, rc.gy10, rc.c10, i, fx1, fy4);
+        __m128 n01 = dotSSE2(rc.gx01, rc.gy01, rc.c01, i, fx, fy1);
+        __m128 n11 = dotSSE2(rc.gx11, rc.gy11, rc.c11, i, fx1, fy1);
+        __m128 value = lerpSSE2(lerpSSE2(n00, n10, u), lerpSSE2(n01, n11, u), v4);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(value, amp4)));
+    }
+    return i;
+}
+#endif
+
+}
+
+PerlinBatch::PerlinBatch(const siv::PerlinNoise::state_type& permutation) {
+    std::copy(permutation.begin(), permutation.end(), perm);
+    double z = SIVPERLIN_DEFAULT_Z;
+    double fz = z - std::floor(z);
+    fadeZ = fade(static_cast<float>(fz));
+    lowerZ = static_cast<float>(fz);
+    upperZ = static_cast<float>(fz - 1.0);
+}
+
+// 격자점 (cellX, cellY)의 z 아래/위 기울기를 fadeZ로 미리 보간해 2D 기울기와 상수항으로 만든다
+PerlinBatch::Corner PerlinBatch::makeCorner(int cellX, int cellY) const {
+    uint8_t h = perm[(perm[cellX & 255] + cellY) & 255];
+    float lx, ly, lz, ux, uy, uz;
+    gradientFor(perm[h], lx, ly, lz);
+    gradientFor(perm[(h + 1) & 255], ux, uy, uz);
+    return {lerp(lx, ux, fadeZ), lerp(ly, uy, fadeZ), lerp(lz * lowerZ, uz * upperZ, fadeZ)};
+}
+
+void PerlinBatch::octave2D_01(int originX, int originY, double frequency, int width, int height,
+                              int octaves, float persistence, float* out) const {
+    width = std::min(width, MAX_WIDTH);
+    octaves = std::min(octaves, MAX_OCTAVES);
+    std::fill(out, out + width * height, 0.0f);
+
+    Columns cols;
+    RowCorners rc;
+    Corner lowerRow[MAX_WIDTH + 2], upperRow[MAX_WIDTH + 2]; // 격자 행 cy, cy + 1의 격자점
+
+    float amplitude = 1.0f;
+    double scale = 1.0;
+    for (int octave = 0; octave < octaves; ++octave) {
+        // 열 정보는 모든 행이 공유
+        double firstX = (static_cast<double>(originX) * frequency) * scale;
+        long long firstCell = static_cast<long long>(std::floor(firstX));
+        int cellSpan = 0;
+        for (int col = 0; col < width; ++col) {
+            double x = (static_cast<double>(originX + col) * frequency) * scale;
+            double cellX = std::floor(x);
+            cols.fx[col] = static_cast<float>(x - cellX);
+            cols.u[col] = fade(cols.fx[col]);
+            cols.cell[col] = static_cast<int>(static_cast<long long>(cellX) - firstCell);
+            cellSpan = cols.cell[col];
+        }
+
+        bool haveRows = false;
+        long long cachedCellY = 0;
+        for (int row = 0; row < height; ++row) {
+            double y = (static_cast<double>(originY + row) * frequency) * scale;
+            double cellYf = std::floor(y);
+            long long cellY = static_cast<long long>(cellYf);
+            float fy = static_cast<float>(y - cellYf);
+
+            // 격자 행이 바뀔 때만 순열 조회, 한 칸 내려간 경우 위 행을 재사용
+            if (!haveRows || cellY != cachedCellY) {
+                int lowerY = static_cast<int>(cellY & 255);
+                int upperY = static_cast<int>((cellY + 1) & 255);
+                for (int col = 0; col < width; ++col) {
+                    Corner c00, c10, c01, c11;
+                    if (cellSpan <= MAX_WIDTH) {
+                        // 이웃한 열이 같은 격자점을 쓰므로 격자점 단위로 한 번씩만 계산
+                        if (col == 0) {
+                            bool shiftByOne = haveRows && cellY == cachedCellY + 1;
+                            for (int k = 0; k <= cellSpan + 1; ++k) {
+                                int cellX = static_cast<int>((firstCell + k) & 255);
+                                lowerRow[k] = shiftByOne ? upperRow[k] : makeCorner(cellX, lowerY);
+                                upperRow[k] = makeCorner(cellX, upperY);
+                            }
+                        }
+                        int k = cols.cell[col];
+                        c00 = lowerRow[k];
+                        c10 = lowerRow[k + 1];
+                        c01 = upperRow[k];
+                        c11 = upperRow[k + 1];
+                    } else {
+                        // 열 간격이 격자보다 넓은 높은 옥타브: 열마다 직접 계산
+                        int cellX = static_cast<int>((firstCell + cols.cell[col]) & 255);
+                        c00 = makeCorner(cellX, lowerY);
+                        c10 = makeCorner(cellX + 1, lowerY);
+                        c01 = makeCorner(cellX, upperY);
+                        c11 = makeCorner(cellX + 1, upperY);
+                    }
+                    rc.gx00[col] = c00.gx; rc.gy00[col] = c00.gy; rc.c00[col] = c00.c;
+                    rc.gx10[col] = c10.gx; rc.gy10[col] = c10.gy; rc.c10[col] = c10.c;
+                    rc.gx01[col] = c01.gx; rc.gy01[col] = c01.gy; rc.c01[col] = c01.c;
+                    rc.gx11[col] = c11.gx; rc.gy11[col] = c11.gy; rc.c11[col] = c11.c;
+                }
+                haveRows = true;
+                cachedCellY = cellY;
+            }
+
+            float* outRow = out + row * width;
+            int done = 0;
+#if JOOM_PERLIN_SSE2
+            done = accumulateSSE2(cols, rc, fy, fade(fy), amplitude, width, outRow);
+#endif
+            accumulateScalar(cols, rc, fy, fade(fy), amplitude, done, width, outRow);
+        }
+
+        amplitude *= persistence;
+        scale *= 2.0;
+    }
+
+    // RemapClamp_01
+    for (int i = 0; i < width * height; ++i) {
+        out[i] = std::min(1.0f, std::max(0.0f, out[i] * 0.5f + 0.5f));
+    }
+}
@@ -0,0 +1,295 @@
+#include "RegionStore.h"
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const size_t REGION_FILE_SIZE = sizeof(RegionHeader) + static_cast<size_t>(REGION_CHUNKS) * sizeof(Chunk);
+
+// 쓰기 묶음 기준: 이만큼 쌓이거나 시간이 지나면 기록
+const size_t WRITE_BATCH_CHUNKS = 64;
+const std::chrono::milliseconds WRITE_INTERVAL(500);
+
+int regionIndex(int chunkX, int chunkY) {
+    return ((chunkY & (REGION_SIZE - 1)) << REGION_SHIFT) | (chunkX & (REGION_SIZE - 1));
+}
+
+uint32_t slotOffset(int index) {
+    return static_cast<uint32_t>(sizeof(RegionHeader) + static_cast<size_t>(index) * sizeof(Chunk));
+}
+
+bool isValidHeader(const RegionHeader& header, int regionX, int regionY) {
+    return std::memcmp(header.magic, "JMRG", 4) == 0 && header.version == REGION_VERSION &&
+           header.regionX == regionX && header.regionY == regionY && header.chunkBytes == sizeof(Chunk);
+}
+
+// 헤더나 크기가 맞지 않는 리전 파일을 <path>.corrupt (이미 있으면 .corrupt.1, .corrupt.2, ...)로 옮긴다
+bool moveAsideCorrupt(const std::string& path) {
+    std::string aside = path + ".corrupt";
+    for (int suffix = 1; std::filesystem::exists(aside); ++suffix) {
+        aside = path + ".corrupt." + std::to_string(suffix);
+    }
+    std::error_code error;
+    std::filesystem::rename(path, aside, error);
+    if (error) {
+        std::cerr << "Invalid region file " << path << " could not be moved aside (" << error.message()
+                  << "), not writing to this region" << std::endl;
+        return false;
+    }
+    std::cerr << "Invalid region file " << path << " moved to " << aside << std::endl;
+    return true;
+}
+
+// 빈 리전 파일 생성 (모든 슬롯 비어 있음)
+bool createRegionFile(const std::string& path, int regionX, int regionY) {
+    RegionHeader header = {};
+    std::memcpy(header.magic, "JMRG", 4);
+    header.version = REGION_VERSION;
+    header.regionX = regionX;
+    header.regionY = regionY;
+    header.chunkBytes = sizeof(Chunk);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::vector<char> emptySlots(REGION_FILE_SIZE - sizeof(header), 0);
+    file.write(emptySlots.data(), emptySlots.size());
+    return static_cast<bool>(file);
+}
+}
+
+RegionStore::RegionStore(const std::string& dir)
+    : directory(dir), open(false), stopping(false), flushRequests(0), chunksWritten(0) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Failed to create chunk store directory " << directory << ": " << error.message() << std::endl;
+        return;
+    }
+    open = true;
+    writer = std::thread(&RegionStore::writerLoop, this);
+}
+
+RegionStore::~RegionStore() {
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+        }
+        wakeCondition.notify_all();
+        writer.join();
+    }
+    closeRegions();
+}
+
+std::string RegionStore::regionPath(int regionX, int regionY) const {
+    return directory + "/r." + std::to_string(regionX) + "." + std::to_string(regionY) + ".bin";
+}
+
+bool RegionStore::findPending(const std::vector<PendingWrite>& writes, int chunkX, int chunkY, Chunk& chunk) {
+    for (auto it = writes.rbegin(); it != writes.rend(); ++it) {
+        if (it->chunkX == chunkX && it->chunkY == chunkY) {
+            chunk = it->chunk;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RegionStore::readChunk(int chunkX, int chunkY, Chunk& chunk) {
+    if (!open) return false;
+    {
+        // 아직 파일에 없는 최신 내용이 먼저
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (findPending(queued, chunkX, chunkY, chunk) || findPending(writing, chunkX, chunkY, chunk)) return true;
+    }
+
+    std::lock_guard<std::mutex> lock(regionMutex);
+    Region* region = openRegion(chunkX >> REGION_SHIFT, chunkY >> REGION_SHIFT, false);
+    if (!region) return false;
+    int index = regionIndex(chunkX, chunkY);
+
+#ifdef _WIN32
+    std::ifstream file(regionPath(chunkX >> REGION_SHIFT, chunkY >> REGION_SHIFT), std::ios::binary);
+    uint32_t offset = 0;
+    file.seekg(offsetof(RegionHeader, offsets) + index * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+    if (!file || offset == 0) return false;
+    file.seekg(offset);
+    file.read(reinterpret_cast<char*>(&chunk), sizeof(Chunk));
+    return static_cast<bool>(file);
+#else
+    const RegionHeader* header = reinterpret_cast<const RegionHeader*>(region->data);
+    uint32_t offset = header->offsets[index];
+    if (offset == 0 || offset + sizeof(Chunk) > region->size) return false;
+    std::memcpy(&chunk, region->data + offset, sizeof(Chunk));
+    return true;
+#endif
+}
+
+void RegionStore::queueWrite(int chunkX, int chunkY, const Chunk& chunk) {
+    if (!open) return;
+    bool batchFull;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queued.push_back({chunkX, chunkY, chunk});
+        batchFull = queued.size() >= WRITE_BATCH_CHUNKS;
+    }
+    if (batchFull) wakeCondition.notify_one();
+}
+
+void RegionStore::flush() {
+    if (!open) return;
+    std::unique_lock<std::mutex> lock(queueMutex);
+    ++flushRequests;
+    wakeCondition.notify_one();
+    flushedCondition.wait(lock, [this] { return queued.empty() && writing.empty(); });
+    --flushRequests;
+}
+
+long long RegionStore::getChunksWritten() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return chunksWritten;
+}
+
+void RegionStore::writerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        wakeCondition.wait_for(lock, WRITE_INTERVAL, [this] {
+            return stopping || queued.size() >= WRITE_BATCH_CHUNKS || (flushRequests > 0 && !queued.empty());
+        });
+        if (queued.empty()) {
+            if (stopping) return;
+            continue;
+        }
+
+        writing.swap(queued);
+        lock.unlock();
+        writeBatch(writing);
+        lock.lock();
+        chunksWritten += static_cast<long long>(writing.size());
+        writing.clear();
+        if (queued.empty()) flushedCondition.notify_all();
+    }
+}
+
+void RegionStore::writeBatch(const std::vector<PendingWrite>& batch) {
+    // 리전별로 묶어서 파일을 한 번씩만 연다 (같은 청크는 나중 것이 덮어쓰도록 순서 유지)
+    std::map<std::pair<int, int>, std::vector<const Chunk*>> byRegion;
+    for (const PendingWrite& write : batch) {
+        std::vector<const Chunk*>& slots = byRegion[{write.chunkX >> REGION_SHIFT, write.chunkY >> REGION_SHIFT}];
+        slots.resize(REGION_CHUNKS, nullptr);
+        slots[regionIndex(write.chunkX, write.chunkY)] = &write.chunk;
+    }
+
+    std::lock_guard<std::mutex> lock(regionMutex);
+    for (const auto& entry : byRegion) {
+        writeRegionLocked(entry.first.first, entry.first.second, entry.second.data());
+    }
+}
+
+bool RegionStore::writeRegion(int regionX, int regionY, const Chunk* const* chunks) {
+    if (!open) return false;
+    std::lock_guard<std::mutex> lock(regionMutex);
+    return writeRegionLocked(regionX, regionY, chunks);
+}
+
+// regionMutex를 잡은 상태에서 호출. 슬롯을 순서대로 쓴 뒤 헤더(인덱스)를 한 번에 갱신한다
+bool RegionStore::writeRegionLocked(int regionX, int regionY, const Chunk* const* chunks) {
+    if (!openRegion(regionX, regionY, true)) return false;
+
+    // 매핑은 같은 페이지 캐시를 공유하므로 파일에 쓴 내용이 바로 보인다
+    std::string path = regionPath(regionX, regionY);
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    RegionHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Failed to open region file " << path << std::endl;
+        return false;
+    }
+
+    int nextSlot = -1; // 연속된 슬롯은 seek 없이 이어서 기록
+    for (int index = 0; index < REGION_CHUNKS; ++index) {
+        if (!chunks[index]) continue;
+        if (index != nextSlot) file.seekp(slotOffset(index));
+        file.write(reinterpret_cast<const char*>(chunks[index]), sizeof(Chunk));
+        header.offsets[index] = slotOffset(index);
+        nextSlot = index + 1;
+    }
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.flush();
+    if (!file) {
+        std::cerr << "Failed to write region file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// regionMutex를 잡은 상태에서 호출
+RegionStore::Region* RegionStore::openRegion(int regionX, int regionY, bool create) {
+    std::pair<int, int> key(regionX, regionY);
+    auto it = regions.find(key);
+    if (it != regions.end()) return &it->second;
+    if (!create && missingRegions.count(key)) return nullptr;
+
+    std::string path = regionPath(regionX, regionY);
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        Region region = {nullptr, 0, -1};
+        bool valid = false;
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        RegionHeader header;
+        if (file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            file.seekg(0, std::ios::end);
+            valid = isValidHeader(header, regionX, regionY) && static_cast<size_t>(file.tellg()) >= REGION_FILE_SIZE;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd >= 0 && fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= REGION_FILE_SIZE) {
+            void* mapped = mmap(nullptr, REGION_FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) {
+                region = {static_cast<const unsigned char*>(mapped), REGION_FILE_SIZE, fd};
+                valid = isValidHeader(*reinterpret_cast<const RegionHeader*>(mapped), regionX, regionY);
+                if (!valid) munmap(mapped, REGION_FILE_SIZE);
+            }
+        }
+        if (!valid && fd >= 0) ::close(fd);
+#endif
+        if (valid) {
+            missingRegions.erase(key);
+            return &(regions[key] = region);
+        }
+
+        // 없거나 형식이 다른 파일: 읽기에서는 없는 것으로, 쓰기에서는 새로 만든다.
+        // 망가진 파일은 지우지 않고 옆으로 옮겨 둔다 (옮기지 못하면 이 리전에는 쓰지 않는다)
+        if (!create || attempt > 0) break;
+        if (std::filesystem::exists(path) && !moveAsideCorrupt(path)) break;
+        if (!createRegionFile(path, regionX, regionY)) {
+            std::cerr << "Failed to create region file " << path << std::endl;
+            break;
+        }
+    }
+    missingRegions.insert(key);
+    return nullptr;
+}
+
+void RegionStore::closeRegions() {
+#ifndef _WIN32
+    for (auto& entry : regions) {
+        munmap(const_cast<unsigned char*>(entry.second.data), entry.second.size);
+        ::close(entry.second.fd);
+    }
+#endif
+    regions.clear();
+}
@@ -7,16 +7,64 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+// 0.0 ~ 1.0 밝기를 8.8 고정소수점 (256 = 1.0)으로 변환
+int toLightLevel(float lighting) {
+    return static_cast<int>(std::clamp(lighting, 0.0f, 1.0f) * 256.0f);
+}
+
+// 바닥 한 픽셀이 덮는 월드 면적(worldArea)에 맞는 밉 단계: 텍셀 면적의 log2 절반
+int selectFloorMip(const TextureDesc* texture, float worldArea) {
+    float lod = 0.5f * std::log2(worldArea * texture->width * texture->height);
+    if (lod >= texture->mipCount - 1) return texture->mipCount - 1;
+    return lod > 0.0f ? static_cast<int>(lod) : 0;
+}
+
+// 한 밝기 단계의 셰이드 테이블 행으로 색을 스케일
+inline Uint32 applyShade(Uint32 color, const Uint8* shade) {
+    return (color & 0xFF000000) |
+           (static_cast<Uint32>(shade[(color >> 16) & 0xFF]) << 16) |
+           (static_cast<Uint32>(shade[(color >> 8) & 0xFF]) << 8) |
+           static_cast<Uint32>(shade[color & 0xFF]);
+}
+
+} // namespace
+
 Renderer::Renderer(SDL_Renderer* sdlRenderer, int width, int height, TextureManager* texMgr, LightSystem* lights)
-    : renderer(sdlRenderer), screenWidth(width), screenHeight(height), textureManager(texMgr), lightSystem(lights) {
+    : renderer(sdlRenderer), screenWidth(width), screenHeight(height), textureManager(texMgr), lightSystem(lights),
+      floorTexture(INVALID_TEXTURE_HANDLE), ceilingTexture(INVALID_TEXTURE_HANDLE),
+      wallTextures{INVALID_TEXTURE_HANDLE, INVALID_TEXTURE_HANDLE, INVALID_TEXTURE_HANDLE},
+      itemTextures{INVALID_TEXTURE_HANDLE, INVALID_TEXTURE_HANDLE, INVALID_TEXTURE_HANDLE,
+                   INVALID_TEXTURE_HANDLE, INVALID_TEXTURE_HANDLE, INVALID_TEXTURE_HANDLE},
+      monsterTexture(INVALID_TEXTURE_HANDLE),
+      wallCaster(WallCaster::DDA), spanKernel(SpanKernel::Scalar), floorSpanKernel(getFloorSpanKernel(SpanKernel::Scalar)),
+      lightingMode(DEFAULT_LIGHTING_MODE), mipmapping(true) {
     
     depthBuffer.resize(screenWidth);
+    int floorBands = (screenHeight - screenHeight / 2 + FLOOR_ROWS_PER_JOB - 1) / FLOOR_ROWS_PER_JOB;
+    floorLightLevels.resize(static_cast<size_t>(floorBands) * screenWidth);
+    floorPixelLighting.resize(static_cast<size_t>(floorBands) * screenWidth);
+    columnAngleOffsets.resize(screenWidth);
+    columnCos.resize(screenWidth);
+    columnSin.resize(screenWidth);
+    columnTan.resize(screenWidth);
+    float angleIncrement = degreesToRadians(FOV) / screenWidth;
+    for (int x = 0; x < screenWidth; ++x) {
+        columnAngleOffsets[x] = x * angleIncrement - degreesToRadians(FOV / 2);
+        columnCos[x] = std::cos(columnAngleOffsets[x]);
+        columnSin[x] = std::sin(columnAngleOffsets[x]);
+        columnTan[x] = std::tan(columnAngleOffsets[x]);
+    }
+    jobSystem = std::make_unique<JobSystem>(JobSystem::resolveThreadCount(0));
+    buildShadeTable();
     screenBuffer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, screenWidth, screenHeight);
 
     // Profiling variables
     profilingTimer = SDL_GetTicks();
     wallTimeAccumulator = 0;
     floorTimeAccumulator = 0;
+    spriteTimeAccumulator = 0;
     frameCounterForProfile = 0;
 }
 
@@ -32,6 +80,98 @@ Renderer::~Renderer() {
 
 }
 
+void Renderer::setThreadCount(int threadCount) {
+    int resolved = JobSystem::resolveThreadCount(threadCount);
+    if (resolved != jobSystem->getThreadCount()) {
+        jobSystem = std::make_unique<JobSystem>(resolved);
+    }
+    std::cout << "Render threads: " << resolved << std::endl;
+}
+
+void Renderer::setSpanKernel(SpanKernel kernel) {
+    if (!isSpanKernelSupported(kernel)) {
+        std::cerr << getSpanKernelName(kernel) << " span kernel is not supported on this CPU" << std::endl;
+        kernel = detectSpanKernel();
+    }
+
+    // SIMD 커널은 사용 전에 스칼라 기준 구현과 결과를 비교
+    if (kernel != SpanKernel::Scalar) {
+        int mismatches = compareFloorSpanKernels(kernel, SpanKernel::Scalar, 64);
+        if (mismatches > 0) {
+            std::cerr << getSpanKernelName(kernel) << " span kernel differs from scalar reference in "
+                      << mismatches << " pixels, falling back to scalar" << std::endl;
+            kernel = SpanKernel::Scalar;
+        }
+    }
+
+    spanKernel = kernel;
+    floorSpanKernel = getFloorSpanKernel(kernel);
+    std::cout << "Floor span kernel: " << getSpanKernelName(kernel) << std::endl;
+}
+
+void Renderer::buildShadeTable() {
+    // 바닥 span 커널과 같은 (c * level) >> 8 연산으로 채워 벽과 바닥의 음영이 일치하도록 한다
+    shadeTable.resize(LIGHT_LEVELS * 256);
+    for (int level = 0; level < LIGHT_LEVELS; ++level) {
+        for (int c = 0; c < 256; ++c) {
+            shadeTable[level * 256 + c] = static_cast<Uint8>((c * level) >> 8);
+        }
+    }
+}
+
+int Renderer::measureFixedLightingError() const {
+    int maxError = 0;
+    const int samples = 4096;
+    for (int i = 0; i <= samples; ++i) {
+        float lighting = static_cast<float>(i) / samples;
+        const Uint8* shade = &shadeTable[toLightLevel(lighting) * 256];
+        for (int c = 0; c < 256; ++c) {
+            Uint32 color = 0xFF000000 | (c << 16) | (c << 8) | c;
+            int expected = applyLighting(color, lighting) & 0xFF;
+            int actual = applyShade(color, shade) & 0xFF;
+            maxError = std::max(maxError, std::abs(expected - actual));
+        }
+    }
+
+    // 바닥/천장: 회색 0~255를 한 줄로 둔 256x1 텍스처를 현재 span 커널로 그린다 (픽셀 i가 텍셀 i)
+    std::vector<uint32_t> ramp(256), floorRow(256), ceilingRow(256);
+    for (int c = 0; c < 256; ++c) ramp[c] = 0xFF000000 | (c << 16) | (c << 8) | c;
+    FloorSpanParams span;
+    span.floorPixels = span.ceilingPixels = ramp.data();
+    span.floorWidthLog2 = span.ceilingWidthLog2 = 8;
+    span.floorHeightLog2 = span.ceilingHeightLog2 = 0;
+    span.startX = 0.5f / 256.0f;
+    span.stepX = 1.0f / 256.0f;
+    span.startY = span.stepY = 0.0f;
+    span.lightLevels = nullptr;
+    span.count = 256;
+    span.floorOut = floorRow.data();
+    span.ceilingOut = ceilingRow.data();
+    for (int i = 0; i <= samples; ++i) {
+        float lighting = static_cast<float>(i) / samples;
+        span.lightLevel = toLightLevel(lighting);
+        floorSpanKernel(span);
+        for (int c = 0; c < 256; ++c) {
+            int expected = applyLighting(ramp[c], lighting) & 0xFF;
+            maxError = std::max(maxError, std::abs(expected - static_cast<int>(floorRow[c] & 0xFF)));
+            maxError = std::max(maxError, std::abs(expected - static_cast<int>(ceilingRow[c] & 0xFF)));
+        }
+    }
+    return maxError;
+}
+
+void Renderer::setLightingMode(LightingMode mode) {
+    if (mode == LightingMode::FixedPoint) {
+        int maxError = measureFixedLightingError();
+        std::cout << "Fixed-point lighting max channel error vs float: " << maxError << std::endl;
+        if (maxError > MAX_FIXED_LIGHTING_ERROR) {
+            std::cerr << "Fixed-point lighting exceeds error bound, using float lighting" << std::endl;
+            mode = LightingMode::Float;
+        }
+    }
+    lightingMode = mode;
+}
+
 void Renderer::initializeTextures() {
     // 각 텍스처를 개별적으로 로딩 시도
     bool brick_loaded = textureManager->loadTexture("wall_brick", "wall_brick.png");
@@ -56,6 +196,35 @@ void Renderer::initializeTextures() {
     if (!ceiling_loaded) {
         textureManager->createCeilingTexture("ceiling_metal", 64, 64);
     }
+
+    // 이름은 여기서 한 번만 핸들로 해석하고, 프레임 중에는 핸들만 사용
+    floorTexture = textureManager->getHandle("floor_stone");
+    ceilingTexture = textureManager->getHandle("ceiling_metal");
+    wallTextures[0] = textureManager->getHandle("wall_brick");
+    wallTextures[1] = textureManager->getHandle("wall_stone");
+    wallTextures[2] = textureManager->getHandle("wall_metal");
+
+    // 벽은 열 단위로 그리므로 열 우선 사본을 추가로 만든다 (바닥/천장은 행 우선 그대로)
+    for (TextureHandle handle : wallTextures) {
+        textureManager->buildColumnMajorCopy(handle);
+    }
+
+    // 스프라이트는 알파가 필요해 항상 절차적으로 만든다. 벽처럼 열 단위로 그리므로 열 우선 사본도 만든다
+    textureManager->createSpriteTexture("item_key_red", 64, 0, 0xFFD03030);
+    textureManager->createSpriteTexture("item_key_blue", 64, 0, 0xFF3050E0);
+    textureManager->createSpriteTexture("item_key_yellow", 64, 0, 0xFFE0C030);
+    textureManager->createSpriteTexture("item_health", 64, 1, 0xFFE0E0E0);
+    textureManager->createSpriteTexture("item_ammo", 64, 2, 0xFFC89A40);
+    textureManager->createSpriteTexture("item_exit", 64, 3, 0xFF9040E0);
+    textureManager->createSpriteTexture("monster", 64, 4, 0xFF702020);
+    const char* itemTextureNames[6] = {"item_key_red", "item_key_blue", "item_key_yellow",
+                                       "item_health", "item_ammo", "item_exit"};
+    for (int i = 0; i < 6; ++i) {
+        itemTextures[i] = textureManager->getHandle(itemTextureNames[i]);
+        textureManager->buildColumnMajorCopy(itemTextures[i]);
+    }
+    monsterTexture = textureManager->getHandle("monster");
+    textureManager->buildColumnMajorCopy(monsterTexture);
 }
 
 void Renderer::present() {
@@ -66,48 +235,66 @@ void Renderer::present() {
         if (frameCounterForProfile > 0) {
             float avgWallTime = (float)wallTimeAccumulator / frameCounterForProfile;
             float avgFloorTime = (float)floorTimeAccumulator / frameCounterForProfile;
-            std::cout << "Avg Frame Time -> Walls: " << avgWallTime << "ms, Floor/Ceiling: " << avgFloorTime << "ms" << std::endl;
+            float avgSpriteTime = (float)spriteTimeAccumulator / frameCounterForProfile;
+            std::cout << "Avg Frame Time -> Walls: " << avgWallTime << "ms, Floor/Ceiling: " << avgFloorTime
+                      << "ms, Sprites: " << avgSpriteTime << "ms" << std::endl;
         }
         profilingTimer = SDL_GetTicks();
         wallTimeAccumulator = 0;
         floorTimeAccumulator = 0;
+        spriteTimeAccumulator = 0;
         frameCounterForProfile = 0;
     }
 }
 
-void Renderer::render(Player* player, Map* map, const std::vector<Item>& items, const Monster* monster) {
+void Renderer::render(Player* player, Map* map, const std::vector<SpriteState>& sprites, float interpolation) {
     void* pixels;
     int pitch;
     SDL_LockTexture(screenBuffer, NULL, &pixels, &pitch);
 
     Uint32* pixelPtr = static_cast<Uint32*>(pixels);
 
-    if (!lightSystem->isFlashlightEnabled()) {
+    // 손전등이 꺼져 있어도 점광원이 있으면 그 주변은 그린다
+    if (!lightSystem->isFlashlightEnabled() && lightSystem->getPointLightGrid().isEmpty()) {
         SDL_memset(pixelPtr, 0, screenHeight * pitch);
     } else {
-        renderFloorAndCeiling(player, pixelPtr);
-        renderWalls(player, map, pixelPtr);
-        // renderSprites(player, items, monster, pixelPtr); // Sprites are disabled for now
+        // 바닥/천장을 행 단위로 나눠 그린 뒤, 그 위에 벽을 열 단위로 나눠 그린다.
+        // 각 작업은 자신이 맡은 픽셀과 depthBuffer 구간에만 쓰므로 스레드 수와 무관하게 결과가 같다.
+        Uint32 floorStart = SDL_GetTicks();
+        int floorRows = screenHeight - screenHeight / 2;
+        jobSystem->parallelFor(floorRows, FLOOR_ROWS_PER_JOB, [&](int rowBegin, int rowEnd) {
+            renderFloorAndCeiling(player, pixelPtr, rowBegin, rowEnd);
+        });
+
+        Uint32 wallStart = SDL_GetTicks();
+        jobSystem->parallelFor(screenWidth, WALL_COLUMNS_PER_JOB, [&](int columnBegin, int columnEnd) {
+            renderWalls(player, map, pixelPtr, columnBegin, columnEnd);
+        });
+
+        // 스프라이트는 벽이 채운 depthBuffer로 열마다 가려짐을 판정하므로 벽 다음에 그린다
+        Uint32 spriteStart = SDL_GetTicks();
+        prepareSprites(player, sprites, interpolation);
+        if (!visibleSprites.empty()) {
+            jobSystem->parallelFor(screenWidth, WALL_COLUMNS_PER_JOB, [&](int columnBegin, int columnEnd) {
+                renderSprites(pixelPtr, columnBegin, columnEnd);
+            });
+        }
+
+        floorTimeAccumulator += wallStart - floorStart;
+        wallTimeAccumulator += spriteStart - wallStart;
+        spriteTimeAccumulator += SDL_GetTicks() - spriteStart;
+        frameCounterForProfile++;
     }
 
     SDL_UnlockTexture(screenBuffer);
 }
 
 Uint32 Renderer::applyLighting(Uint32 color, float lighting) const {
-    lighting = std::clamp(lighting, 0.0f, 1.0f);
-    Uint8 a = (color >> 24) & 0xFF;
-    Uint8 r = (color >> 16) & 0xFF;
-    Uint8 g = (color >> 8) & 0xFF;
-    Uint8 b = color & 0xFF;
-
-    r = static_cast<Uint8>(r * lighting);
-    g = static_cast<Uint8>(g * lighting);
-    b = static_cast<Uint8>(b * lighting);
-
-    return (a << 24) | (r << 16) | (g << 8) | b;
+    // 바닥/천장 float 커널과 같은 연산
+    return shadeColorFloat(color, lighting);
 }
 
-void Renderer::renderFloorAndCeiling(Player* player, Uint32* pixels) {
+void Renderer::renderFloorAndCeiling(Player* player, Uint32* pixels, int rowBegin, int rowEnd) {
     float playerX = player->getX();
     float playerY = player->getY();
     float playerAngle = player->getAngle();
@@ -118,122 +305,363 @@ void Renderer::renderFloorAndCeiling(Player* player, Uint32* pixels) {
     float rayDirX1 = cos(playerAngle + fovRadians / 2);
     float rayDirY1 = sin(playerAngle + fovRadians / 2);
 
-    int floorTexWidth, floorTexHeight, ceilingTexWidth, ceilingTexHeight;
-    const std::vector<Uint32>* floorPixels = textureManager->getPixels("floor_stone", floorTexWidth, floorTexHeight);
-    const std::vector<Uint32>* ceilingPixels = textureManager->getPixels("ceiling_metal", ceilingTexWidth, ceilingTexHeight);
+    const TextureDesc* floorTex = textureManager->getDesc(floorTexture);
+    const TextureDesc* ceilingTex = textureManager->getDesc(ceilingTexture);
+
+    if (!floorTex || !ceilingTex) return;
 
-    if (!floorPixels || !ceilingPixels) return;
+    FloorSpanParams span;
+    span.count = screenWidth;
+    span.lightLevels = nullptr;
 
-    for (int y = screenHeight / 2; y < screenHeight; ++y) {
+    // 점광원 격자가 닿는 행은 픽셀마다 타일 밝기를 더한다
+    const LightGrid& pointLights = lightSystem->getPointLightGrid();
+    LightGridSampler lightSampler(pointLights);
+    int litMinX = 0, litMinY = 0, litMaxX = -1, litMaxY = -1;
+    bool pointLit = !pointLights.isEmpty();
+    if (pointLit) {
+        pointLights.getLitBounds(litMinX, litMinY, litMaxX, litMaxY);
+    }
+    // parallelFor는 작업을 grain의 배수에서 시작하므로 rowBegin으로 이 띠의 버퍼를 찾는다
+    size_t bandOffset = static_cast<size_t>(rowBegin / FLOOR_ROWS_PER_JOB) * screenWidth;
+    uint16_t* lightLevels = floorLightLevels.data() + bandOffset;
+    float* pixelLighting = floorPixelLighting.data() + bandOffset;
+    bool floatLighting = lightingMode == LightingMode::Float;
+    bool flashlightEnabled = lightSystem->isFlashlightEnabled();
+
+    for (int y = screenHeight / 2 + rowBegin; y < screenHeight / 2 + rowEnd; ++y) {
         float rowDistance = (0.5f * screenHeight) / (y - screenHeight / 2.0f);
 
-        float floorX_step = rowDistance * (rayDirX1 - rayDirX0) / screenWidth;
-        float floorY_step = rowDistance * (rayDirY1 - rayDirY0) / screenWidth;
+        span.stepX = rowDistance * (rayDirX1 - rayDirX0) / screenWidth;
+        span.stepY = rowDistance * (rayDirY1 - rayDirY0) / screenWidth;
+        span.startX = playerX + rowDistance * rayDirX0;
+        span.startY = playerY + rowDistance * rayDirY0;
+
+        // 한 픽셀의 가로 폭(step)과 다음 행까지의 깊이 변화로 픽셀이 덮는 바닥 면적을 구해 밉 단계를 고른다
+        int floorMip = 0, ceilingMip = 0;
+        if (mipmapping) {
+            float stepLength = std::sqrt(span.stepX * span.stepX + span.stepY * span.stepY);
+            float depthStep = rowDistance * rowDistance / (0.5f * screenHeight);
+            float worldArea = stepLength * depthStep;
+            floorMip = selectFloorMip(floorTex, worldArea);
+            ceilingMip = selectFloorMip(ceilingTex, worldArea);
+        }
+        const TextureMip& floorLevel = floorTex->mips[floorMip];
+        const TextureMip& ceilingLevel = ceilingTex->mips[ceilingMip];
+        span.floorPixels = floorLevel.pixels;
+        span.floorWidthLog2 = floorLevel.widthLog2;
+        span.floorHeightLog2 = floorLevel.heightLog2;
+        span.ceilingPixels = ceilingLevel.pixels;
+        span.ceilingWidthLog2 = ceilingLevel.widthLog2;
+        span.ceilingHeightLog2 = ceilingLevel.heightLog2;
+
+        // 손전등이 꺼져 있으면 점광원만 비춘다 (꺼졌을 때 화면 전체가 어두운 기존 동작 유지)
+        float lighting = flashlightEnabled
+            ? lightSystem->getLightFromDistanceLUT(rowDistance) + lightSystem->getAmbientLight()
+            : 0.0f;
+        span.lightLevel = toLightLevel(lighting);
+        span.lightLevels = nullptr;
+        const float* rowLighting = nullptr;
+
+        if (pointLit) {
+            float endX = span.startX + span.stepX * (screenWidth - 1);
+            float endY = span.startY + span.stepY * (screenWidth - 1);
+            // 행이 지나는 사각형이 빛이 닿은 영역과 겹칠 때만 픽셀별로 계산한다
+            if (std::floor(std::max(span.startX, endX)) >= litMinX && std::floor(std::min(span.startX, endX)) <= litMaxX &&
+                std::floor(std::max(span.startY, endY)) >= litMinY && std::floor(std::min(span.startY, endY)) <= litMaxY) {
+                for (int i = 0; i < screenWidth; ++i) {
+                    int tileX = static_cast<int>(std::floor(span.startX + static_cast<float>(i) * span.stepX));
+                    int tileY = static_cast<int>(std::floor(span.startY + static_cast<float>(i) * span.stepY));
+                    float pixelLight = lighting + lightSampler.sample(tileX, tileY);
+                    if (floatLighting) pixelLighting[i] = pixelLight;
+                    else lightLevels[i] = static_cast<uint16_t>(toLightLevel(pixelLight));
+                }
+                if (floatLighting) rowLighting = pixelLighting;
+                else span.lightLevels = lightLevels;
+            }
+        }
 
-        float floorX = playerX + rowDistance * rayDirX0;
-        float floorY = playerY + rowDistance * rayDirY0;
+        span.floorOut = pixels + y * screenWidth;
+        span.ceilingOut = pixels + (screenHeight - y - 1) * screenWidth;
+        if (floatLighting) floorSpanFloat(span, lighting, rowLighting);
+        else floorSpanKernel(span);
+    }
+}
 
-        float lighting = lightSystem->getLightFromDistanceLUT(rowDistance) + lightSystem->getAmbientLight();
+bool Renderer::castRayDDA(const Map* map, float originX, float originY, float dirX, float dirY, WallHit& hit) const {
+    int mapX = static_cast<int>(floor(originX));
+    int mapY = static_cast<int>(floor(originY));
 
-        for (int x = 0; x < screenWidth; ++x) {
-            int texX_floor = static_cast<int>(floorX * floorTexWidth) & (floorTexWidth - 1);
-            int texY_floor = static_cast<int>(floorY * floorTexHeight) & (floorTexHeight - 1);
-            Uint32 floorColor = (*floorPixels)[texY_floor * floorTexWidth + texX_floor];
+    // Ray length needed to cross one full tile along each axis
+    float deltaDistX = (dirX == 0.0f) ? 1e30f : std::abs(1.0f / dirX);
+    float deltaDistY = (dirY == 0.0f) ? 1e30f : std::abs(1.0f / dirY);
 
-            int texX_ceil = static_cast<int>(floorX * ceilingTexWidth) & (ceilingTexWidth - 1);
-            int texY_ceil = static_cast<int>(floorY * ceilingTexHeight) & (ceilingTexHeight - 1);
-            Uint32 ceilingColor = (*ceilingPixels)[texY_ceil * ceilingTexWidth + texX_ceil];
+    int stepX, stepY;
+    float sideDistX, sideDistY;
+    if (dirX < 0) {
+        stepX = -1;
+        sideDistX = (originX - mapX) * deltaDistX;
+    } else {
+        stepX = 1;
+        sideDistX = (mapX + 1.0f - originX) * deltaDistX;
+    }
+    if (dirY < 0) {
+        stepY = -1;
+        sideDistY = (originY - mapY) * deltaDistY;
+    } else {
+        stepY = 1;
+        sideDistY = (mapY + 1.0f - originY) * deltaDistY;
+    }
 
-            pixels[y * screenWidth + x] = applyLighting(floorColor, lighting);
-            pixels[(screenHeight - y - 1) * screenWidth + x] = applyLighting(ceilingColor, lighting);
+    // Step from tile boundary to tile boundary until a wall is found
+    while (true) {
+        int side;
+        float distance;
+        if (sideDistX < sideDistY) {
+            distance = sideDistX;
+            sideDistX += deltaDistX;
+            mapX += stepX;
+            side = 0;
+        } else {
+            distance = sideDistY;
+            sideDistY += deltaDistY;
+            mapY += stepY;
+            side = 1;
+        }
 
-            floorX += floorX_step;
-            floorY += floorY_step;
+        if (distance >= MAX_RAY_DISTANCE) return false;
+
+        int wallType = map->getWallType(mapX, mapY);
+        if (wallType != 0) {
+            hit.wallType = wallType;
+            hit.distance = distance;
+            hit.hitX = originX + dirX * distance;
+            hit.hitY = originY + dirY * distance;
+            hit.side = side;
+            hit.wallX = (side == 0) ? hit.hitY - floor(hit.hitY) : hit.hitX - floor(hit.hitX);
+            return true;
         }
     }
 }
 
-void Renderer::renderWalls(Player* player, Map* map, Uint32* pixels) {
+bool Renderer::castRayMarch(const Map* map, float originX, float originY, float dirX, float dirY, WallHit& hit) const {
+    const float step = 0.05f;
+    float rayX = originX, rayY = originY;
+    float rayDX = dirX * step, rayDY = dirY * step;
+    float distance = 0;
+
+    while (distance < MAX_RAY_DISTANCE) {
+        rayX += rayDX;
+        rayY += rayDY;
+        distance += step;
+        if (map->isWallAt(rayX, rayY)) {
+            hit.wallType = map->getWallType(static_cast<int>(rayX), static_cast<int>(rayY));
+            hit.distance = distance;
+            hit.hitX = rayX;
+            hit.hitY = rayY;
+
+            // The marcher overshoots the boundary, so guess the face from the nearest grid line
+            if (std::abs(rayX - round(rayX)) < std::abs(rayY - round(rayY))) {
+                hit.side = 0;
+                hit.wallX = rayY - floor(rayY);
+            } else {
+                hit.side = 1;
+                hit.wallX = rayX - floor(rayX);
+            }
+            return hit.wallType != 0;
+        }
+    }
+    return false;
+}
+
+void Renderer::renderWalls(Player* player, Map* map, Uint32* pixels, int columnBegin, int columnEnd) {
     float playerX = player->getX();
     float playerY = player->getY();
     float playerAngle = player->getAngle();
-    float startAngle = playerAngle - degreesToRadians(FOV / 2);
-    float angleIncrement = degreesToRadians(FOV) / screenWidth;
+    float playerCos = std::cos(playerAngle);
+    float playerSin = std::sin(playerAngle);
 
-    std::fill(depthBuffer.begin(), depthBuffer.end(), 20.0f);
+    std::fill(depthBuffer.begin() + columnBegin, depthBuffer.begin() + columnEnd, MAX_RAY_DISTANCE);
 
-    // Pre-fetch texture data
-    int brickW, brickH, stoneW, stoneH, metalW, metalH;
-    const std::vector<Uint32>* brickPx = textureManager->getPixels("wall_brick", brickW, brickH);
-    const std::vector<Uint32>* stonePx = textureManager->getPixels("wall_stone", stoneW, stoneH);
-    const std::vector<Uint32>* metalPx = textureManager->getPixels("wall_metal", metalW, metalH);
+    LightGridSampler lightSampler(lightSystem->getPointLightGrid());
+    bool hasPointLights = !lightSystem->getPointLightGrid().isEmpty();
 
-    for (int x = 0; x < screenWidth; ++x) {
-        float rayAngle = startAngle + x * angleIncrement;
-        
-        float hitX, hitY;
-        int wallType = 0;
-        float distance = 0;
-        float step = 0.05f;
-        float rayX = playerX, rayY = playerY;
-        float rayDX = cos(rayAngle) * step, rayDY = sin(rayAngle) * step;
-
-        while (distance < 20.0f) {
-            rayX += rayDX;
-            rayY += rayDY;
-            distance += step;
-            if (map->isWallAt(rayX, rayY)) {
-                wallType = map->getWallType(static_cast<int>(rayX), static_cast<int>(rayY));
-                hitX = rayX;
-                hitY = rayY;
-                break;
-            }
-        }
+    // Pre-fetch texture descriptors
+    const TextureDesc* wallDescs[3];
+    for (int i = 0; i < 3; ++i) {
+        wallDescs[i] = textureManager->getDesc(wallTextures[i]);
+    }
+
+    for (int x = columnBegin; x < columnEnd; ++x) {
+        // 광선 방향은 시선 방향을 열의 고정 오프셋만큼 회전한 것
+        float rayDirX = playerCos * columnCos[x] - playerSin * columnSin[x];
+        float rayDirY = playerSin * columnCos[x] + playerCos * columnSin[x];
 
-        if (wallType == 0) continue;
+        WallHit hit;
+        bool found = (wallCaster == WallCaster::DDA)
+            ? castRayDDA(map, playerX, playerY, rayDirX, rayDirY, hit)
+            : castRayMarch(map, playerX, playerY, rayDirX, rayDirY, hit);
+        if (!found) continue;
 
-        float correctedDistance = distance * cos(rayAngle - playerAngle);
+        float correctedDistance = hit.distance * columnCos[x];
         depthBuffer[x] = correctedDistance;
 
         int wallHeight = static_cast<int>((screenHeight / correctedDistance) * 0.6f);
         int wallTop = std::max(0, (screenHeight - wallHeight) / 2);
         int wallBottom = std::min(screenHeight, (screenHeight + wallHeight) / 2);
 
-        float wallX;
-        if (std::abs(hitX - round(hitX)) < std::abs(hitY - round(hitY))) {
-            wallX = hitY - floor(hitY);
-        } else {
-            wallX = hitX - floor(hitX);
+        // 알 수 없는 벽 타입은 벽돌로 그린다
+        int textureIndex = (hit.wallType >= 1 && hit.wallType <= 3) ? hit.wallType - 1 : 0;
+        const TextureDesc* texture = wallDescs[textureIndex];
+        if (!texture || !texture->columns) continue;
+
+        float lighting = lightSystem->getConeLight(columnAngleOffsets[x], correctedDistance);
+        if (hasPointLights) {
+            // 벽면은 광선이 벽에 닿기 직전의 빈 타일 밝기를 받는다
+            int tileX = static_cast<int>(std::floor(hit.hitX - rayDirX * 0.01f));
+            int tileY = static_cast<int>(std::floor(hit.hitY - rayDirY * 0.01f));
+            lighting += lightSampler.sample(tileX, tileY);
         }
+        if (lighting < 0.05f) continue;
 
-        const std::vector<Uint32>* texturePx = nullptr;
-        int texWidth = 0, texHeight = 0;
-
-        switch (wallType) {
-            case 1: texturePx = brickPx; texWidth = brickW; texHeight = brickH; break;
-            case 2: texturePx = stonePx; texWidth = stoneW; texHeight = stoneH; break;
-            case 3: texturePx = metalPx; texWidth = metalW; texHeight = metalH; break;
-            default: texturePx = brickPx; texWidth = brickW; texHeight = brickH; break;
+        // 화면 한 픽셀에 텍셀이 2^n개 이상 들어가면 n단계 밉을 사용
+        int mipLevel = 0;
+        if (mipmapping) {
+            while (mipLevel + 1 < texture->mipCount && (wallHeight << (mipLevel + 1)) <= texture->height) {
+                ++mipLevel;
+            }
         }
+        const TextureMip& mip = texture->mips[mipLevel];
+        int texHeight = mip.height;
+
+        int texX = static_cast<int>(hit.wallX * mip.width) & mip.widthMask;
+        const Uint32* column = textureManager->getColumn(wallTextures[textureIndex], texX, mipLevel);
+
+        if (lightingMode == LightingMode::FixedPoint) {
+            const Uint8* shade = &shadeTable[toLightLevel(lighting) * 256];
+            for (int y = wallTop; y < wallBottom; ++y) {
+                float texY_float = (float)(y - wallTop) / (float)wallHeight;
+                int texY = static_cast<int>(texY_float * texHeight) & (texHeight - 1);
+                pixels[y * screenWidth + x] = applyShade(column[texY], shade);
+            }
+        } else {
+            for (int y = wallTop; y < wallBottom; ++y) {
+                float texY_float = (float)(y - wallTop) / (float)wallHeight;
+                int texY = static_cast<int>(texY_float * texHeight) & (texHeight - 1);
+                pixels[y * screenWidth + x] = applyLighting(column[texY], lighting);
+            }
+        }
+    }
+}
 
-        if (!texturePx) continue;
-
-        float lighting = lightSystem->calculateLighting(playerX, playerY, playerAngle, hitX, hitY, correctedDistance);
-        if (lighting < 0.05f) continue;
-
-        int texX = static_cast<int>(wallX * texWidth) & (texWidth - 1);
+void Renderer::prepareSprites(Player* player, const std::vector<SpriteState>& sprites, float interpolation) {
+    visibleSprites.clear();
 
-        for (int y = wallTop; y < wallBottom; ++y) {
-            float texY_float = (float)(y - wallTop) / (float)wallHeight;
-            int texY = static_cast<int>(texY_float * texHeight) & (texHeight - 1);
-            Uint32 color = (*texturePx)[texY * texWidth + texX];
-            pixels[y * screenWidth + x] = applyLighting(color, lighting);
+    float playerX = player->getX();
+    float playerY = player->getY();
+    float playerCos = std::cos(player->getAngle());
+    float playerSin = std::sin(player->getAngle());
+    float halfFov = degreesToRadians(FOV / 2);
+    float columnsPerRadian = screenWidth / degreesToRadians(FOV);
+    LightGridSampler lightSampler(lightSystem->getPointLightGrid());
+
+    // 바닥에 놓인 스프라이트 하나를 카메라 공간으로 옮겨 컬링하고, 남으면 visibleSprites에 추가
+    auto addSprite = [&](float x, float y, float scale, float lift, TextureHandle handle) {
+        const TextureDesc* texture = textureManager->getDesc(handle);
+        if (!texture || !texture->columns) return;
+
+        float dx = x - playerX;
+        float dy = y - playerY;
+        float depth = dx * playerCos + dy * playerSin;
+        if (depth < MIN_SPRITE_DEPTH || depth > MAX_RAY_DISTANCE) return;
+        float lateral = dy * playerCos - dx * playerSin;
+
+        // 좌우 가장자리의 광선 각도로 덮는 열을 구한다 (열 각도는 화면 폭에 선형)
+        float halfWidth = scale * 0.5f;
+        float leftColumn = (std::atan((lateral - halfWidth) / depth) + halfFov) * columnsPerRadian;
+        float rightColumn = (std::atan((lateral + halfWidth) / depth) + halfFov) * columnsPerRadian;
+        int columnStart = std::max(0, static_cast<int>(std::ceil(leftColumn)));
+        int columnEnd = std::min(screenWidth, static_cast<int>(std::floor(rightColumn)) + 1);
+        if (columnStart >= columnEnd) return;
+
+        float lighting = lightSystem->getConeLight(std::atan2(lateral, depth), depth) +
+                         lightSampler.sample(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)));
+        if (lighting < 0.05f) return;
+
+        // 바닥 행 거리 공식 (rowDistance = 0.5 * 화면 높이 / (y - 지평선))에 맞춰 바닥에 세운다
+        float unitHeight = screenHeight / depth;
+        float height = scale * unitHeight;
+
+        SpriteInstance sprite;
+        sprite.depth = depth;
+        sprite.lateral = lateral;
+        sprite.invWidth = 1.0f / scale;
+        sprite.top = screenHeight * 0.5f + 0.5f * unitHeight - (lift * unitHeight) - height;
+        sprite.height = height;
+        sprite.columnStart = columnStart;
+        sprite.columnEnd = columnEnd;
+        sprite.texture = handle;
+        sprite.mipLevel = 0;
+        if (mipmapping) {
+            int spriteHeight = static_cast<int>(height);
+            while (sprite.mipLevel + 1 < texture->mipCount && (spriteHeight << (sprite.mipLevel + 1)) <= texture->height) {
+                ++sprite.mipLevel;
+            }
+        }
+        sprite.lighting = lighting;
+        visibleSprites.push_back(sprite);
+    };
+
+    for (const SpriteState& state : sprites) {
+        float x = state.previousX + (state.x - state.previousX) * interpolation;
+        float y = state.previousY + (state.y - state.previousY) * interpolation;
+        if (state.kind == SPRITE_KIND_MONSTER) {
+            addSprite(x, y, MONSTER_SPRITE_SCALE, state.lift, monsterTexture);
+        } else if (state.kind >= 0 && state.kind < 6) {
+            addSprite(x, y, ITEM_SPRITE_SCALE, state.lift, itemTextures[state.kind]);
         }
     }
+
+    // 먼 것부터 그려 가까운 스프라이트가 덮도록 한다
+    std::sort(visibleSprites.begin(), visibleSprites.end(),
+              [](const SpriteInstance& a, const SpriteInstance& b) { return a.depth > b.depth; });
 }
 
-void Renderer::renderSprites(Player* player, const std::vector<Item>& items, const Monster* monster, Uint32* pixels) {
-    // Sprite rendering logic will be implemented here in the future.
+void Renderer::renderSprites(Uint32* pixels, int columnBegin, int columnEnd) {
+    for (const SpriteInstance& sprite : visibleSprites) {
+        int start = std::max(sprite.columnStart, columnBegin);
+        int end = std::min(sprite.columnEnd, columnEnd);
+        if (start >= end) continue;
+
+        const TextureMip& mip = textureManager->getDesc(sprite.texture)->mips[sprite.mipLevel];
+        int rowStart = std::max(0, static_cast<int>(std::ceil(sprite.top)));
+        int rowEnd = std::min(screenHeight, static_cast<int>(std::ceil(sprite.top + sprite.height)));
+        if (rowStart >= rowEnd) continue;
+
+        // 세로 텍스처 좌표는 16.16 고정소수점으로 한 행씩 더해 간다 (픽셀마다 나눗셈 없음)
+        int64_t texStep = static_cast<int64_t>(mip.height * 65536.0f / sprite.height);
+        int64_t texStart = static_cast<int64_t>((rowStart - sprite.top) * mip.height * 65536.0f / sprite.height);
+        const Uint8* shade = &shadeTable[toLightLevel(sprite.lighting) * 256];
+
+        for (int x = start; x < end; ++x) {
+            // 벽보다 뒤에 있는 열은 건너뛴다
+            if (sprite.depth >= depthBuffer[x]) continue;
+
+            // 이 열의 광선이 스프라이트 평면과 만나는 가로 위치
+            float u = (sprite.depth * columnTan[x] - sprite.lateral) * sprite.invWidth + 0.5f;
+            int texX = std::clamp(static_cast<int>(u * mip.width), 0, mip.width - 1);
+            const Uint32* column = textureManager->getColumn(sprite.texture, texX, sprite.mipLevel);
+
+            int64_t texY = texStart;
+            for (int y = rowStart; y < rowEnd; ++y, texY += texStep) {
+                Uint32 texel = column[std::min(static_cast<int>(texY >> 16), mip.height - 1)];
+                if (texel < 0x80000000) continue; // 알파가 절반 미만이면 투명
+                pixels[y * screenWidth + x] = (lightingMode == LightingMode::FixedPoint)
+                    ? applyShade(texel, shade)
+                    : applyLighting(texel, sprite.lighting);
+            }
+        }
+    }
 }
 
 float Renderer::degreesToRadians(float degrees) {
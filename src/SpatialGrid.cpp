@@ -0,0 +1,108 @@
+#include "SpatialGrid.h"
+#include "ChunkTable.h"
+#include <cmath>
+
+SpatialGrid::SpatialGrid() : activeCount(0) {}
+
+int SpatialGrid::cellCoord(float value) {
+    return static_cast<int>(std::floor(value)) >> CELL_SHIFT;
+}
+
+int SpatialGrid::insert(float x, float y, uint32_t layer, uint32_t userData) {
+    int handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<int>(entries.size());
+        entries.emplace_back();
+    }
+    Entry& entry = entries[handle];
+    entry.x = x;
+    entry.y = y;
+    entry.layer = layer;
+    entry.userData = userData;
+    link(handle);
+    ++activeCount;
+    return handle;
+}
+
+void SpatialGrid::move(int handle, float x, float y) {
+    if (handle < 0 || handle >= static_cast<int>(entries.size()) || entries[handle].layer == 0) return;
+    Entry& entry = entries[handle];
+    entry.x = x;
+    entry.y = y;
+    // 같은 칸 안에서 움직이면 위치만 바꾼다
+    if (ChunkTable::packKey(cellCoord(x), cellCoord(y)) == entry.cellKey) return;
+    unlink(handle);
+    link(handle);
+}
+
+void SpatialGrid::remove(int handle) {
+    if (handle < 0 || handle >= static_cast<int>(entries.size()) || entries[handle].layer == 0) return;
+    unlink(handle);
+    entries[handle].layer = 0;
+    freeHandles.push_back(handle);
+    --activeCount;
+}
+
+void SpatialGrid::clear() {
+    entries.clear();
+    freeHandles.clear();
+    cells.clear();
+    activeCount = 0;
+}
+
+void SpatialGrid::link(int handle) {
+    Entry& entry = entries[handle];
+    entry.cellKey = ChunkTable::packKey(cellCoord(entry.x), cellCoord(entry.y));
+    std::vector<int>& cell = cells[entry.cellKey];
+    entry.cellSlot = static_cast<int>(cell.size());
+    cell.push_back(handle);
+}
+
+void SpatialGrid::unlink(int handle) {
+    Entry& entry = entries[handle];
+    auto it = cells.find(entry.cellKey);
+    if (it == cells.end()) return;
+    std::vector<int>& cell = it->second;
+    // 마지막 항목을 빈 자리로 옮겨 O(1)에 제거
+    int last = cell.back();
+    cell[entry.cellSlot] = last;
+    entries[last].cellSlot = entry.cellSlot;
+    cell.pop_back();
+    // 빈 칸도 지우지 않는다. 몬스터가 칸 경계를 오갈 때마다 벡터를 다시 할당하지 않도록 (clear에서 정리)
+}
+
+void SpatialGrid::queryRadius(float x, float y, float radius, uint32_t layerMask, std::vector<int>& results) const {
+    results.clear();
+    float radiusSquared = radius * radius;
+    for (int cellY = cellCoord(y - radius); cellY <= cellCoord(y + radius); ++cellY) {
+        for (int cellX = cellCoord(x - radius); cellX <= cellCoord(x + radius); ++cellX) {
+            auto it = cells.find(ChunkTable::packKey(cellX, cellY));
+            if (it == cells.end()) continue;
+            for (int handle : it->second) {
+                const Entry& entry = entries[handle];
+                if (!(entry.layer & layerMask)) continue;
+                float dx = entry.x - x;
+                float dy = entry.y - y;
+                if (dx * dx + dy * dy < radiusSquared) results.push_back(handle);
+            }
+        }
+    }
+}
+
+void SpatialGrid::queryRect(float minX, float minY, float maxX, float maxY, uint32_t layerMask, std::vector<int>& results) const {
+    results.clear();
+    for (int cellY = cellCoord(minY); cellY <= cellCoord(maxY); ++cellY) {
+        for (int cellX = cellCoord(minX); cellX <= cellCoord(maxX); ++cellX) {
+            auto it = cells.find(ChunkTable::packKey(cellX, cellY));
+            if (it == cells.end()) continue;
+            for (int handle : it->second) {
+                const Entry& entry = entries[handle];
+                if (!(entry.layer & layerMask)) continue;
+                if (entry.x >= minX && entry.x <= maxX && entry.y >= minY && entry.y <= maxY) results.push_back(handle);
+            }
+        }
+    }
+}
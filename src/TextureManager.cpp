@@ -1,6 +1,8 @@
 #include "TextureManager.h"
 #include <SDL2/SDL_image.h>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 TextureManager::TextureManager(SDL_Renderer* renderer, const std::string& textureDir)
     : renderer(renderer), textureDirectory(textureDir) {}
@@ -17,8 +19,8 @@ void TextureManager::cleanup() {
     }
     textures.clear();
     texturePixels.clear();
-    textureWidths.clear();
-    textureHeights.clear();
+    textureDescs.clear();
+    textureHandles.clear();
 }
 
 bool TextureManager::cacheTexturePixels(const std::string& name, SDL_Texture* texture) {
@@ -45,10 +47,122 @@ bool TextureManager::cacheTexturePixels(const std::string& name, SDL_Texture* te
     
     SDL_FreeSurface(surface);
 
-    texturePixels[name] = pixels;
-    textureWidths[name] = width;
-    textureHeights[name] = height;
+    storeTexturePixels(name, std::move(pixels), width, height);
+    return true;
+}
+
+void TextureManager::storeTexturePixels(const std::string& name, std::vector<Uint32> pixels, int width, int height) {
+    // 같은 이름으로 다시 캐시하면 기존 핸들을 유지한다
+    TextureHandle handle;
+    auto it = textureHandles.find(name);
+    if (it != textureHandles.end()) {
+        handle = it->second;
+    } else {
+        handle = static_cast<TextureHandle>(texturePixels.size());
+        texturePixels.emplace_back();
+        textureDescs.emplace_back();
+        textureHandles[name] = handle;
+    }
+
+    TexturePixelData& data = texturePixels[handle];
+    bool hadColumns = !data.columns.empty();
+    data.pixels = std::move(pixels);
+    data.columns.clear();
+    data.width = width;
+    data.height = height;
+    buildMipChain(data);
+
+    // 이미 열 우선 사본이 있던 텍스처라면 새 픽셀로 다시 만든다
+    if (hadColumns) {
+        buildColumnMajorCopy(handle);
+    }
 
+    // 벡터 재할당 후에도 모든 디스크립터가 유효하도록 갱신
+    for (TextureHandle h = 0; h < static_cast<TextureHandle>(texturePixels.size()); ++h) {
+        refreshDesc(h);
+    }
+}
+
+// 0단계 픽셀 뒤에 2x2 박스 필터로 줄인 단계들을 이어 붙인다 (1x1이 될 때까지)
+void TextureManager::buildMipChain(TexturePixelData& data) {
+    data.mipOffsets.assign(1, 0);
+    int width = data.width;
+    int height = data.height;
+    int offset = 0;
+
+    while ((width > 1 || height > 1) && static_cast<int>(data.mipOffsets.size()) < MAX_TEXTURE_MIPS) {
+        int nextWidth = std::max(1, width >> 1);
+        int nextHeight = std::max(1, height >> 1);
+        int nextOffset = offset + width * height;
+        data.pixels.resize(nextOffset + nextWidth * nextHeight);
+
+        const Uint32* src = data.pixels.data() + offset;
+        Uint32* dst = data.pixels.data() + nextOffset;
+        for (int y = 0; y < nextHeight; ++y) {
+            int y0 = y * 2, y1 = std::min(y * 2 + 1, height - 1);
+            for (int x = 0; x < nextWidth; ++x) {
+                int x0 = x * 2, x1 = std::min(x * 2 + 1, width - 1);
+                Uint32 texels[4] = {src[y0 * width + x0], src[y0 * width + x1],
+                                    src[y1 * width + x0], src[y1 * width + x1]};
+                Uint32 result = 0;
+                for (int shift = 0; shift < 32; shift += 8) {
+                    Uint32 sum = 2;
+                    for (Uint32 texel : texels) sum += (texel >> shift) & 0xFF;
+                    result |= (sum >> 2) << shift;
+                }
+                dst[y * nextWidth + x] = result;
+            }
+        }
+
+        data.mipOffsets.push_back(nextOffset);
+        offset = nextOffset;
+        width = nextWidth;
+        height = nextHeight;
+    }
+}
+
+void TextureManager::refreshDesc(TextureHandle handle) {
+    const TexturePixelData& data = texturePixels[handle];
+    TextureDesc& desc = textureDescs[handle];
+
+    desc.mipCount = static_cast<int>(data.mipOffsets.size());
+    for (int level = 0; level < desc.mipCount; ++level) {
+        TextureMip& mip = desc.mips[level];
+        int offset = data.mipOffsets[level];
+        mip.pixels = data.pixels.data() + offset;
+        mip.columns = data.columns.empty() ? nullptr : data.columns.data() + offset;
+        mip.width = std::max(1, data.width >> level);
+        mip.height = std::max(1, data.height >> level);
+        mip.widthLog2 = 0;
+        while ((2 << mip.widthLog2) <= mip.width) ++mip.widthLog2;
+        mip.heightLog2 = 0;
+        while ((2 << mip.heightLog2) <= mip.height) ++mip.heightLog2;
+        mip.widthMask = mip.width - 1;
+        mip.heightMask = mip.height - 1;
+    }
+    static_cast<TextureMip&>(desc) = desc.mips[0];
+}
+
+bool TextureManager::buildColumnMajorCopy(TextureHandle handle) {
+    if (handle < 0 || handle >= static_cast<TextureHandle>(texturePixels.size())) {
+        return false;
+    }
+
+    // 밉 단계마다 같은 오프셋에 전치해서 저장
+    TexturePixelData& data = texturePixels[handle];
+    data.columns.resize(data.pixels.size());
+    for (size_t level = 0; level < data.mipOffsets.size(); ++level) {
+        int width = std::max(1, data.width >> level);
+        int height = std::max(1, data.height >> level);
+        const Uint32* rows = data.pixels.data() + data.mipOffsets[level];
+        Uint32* columns = data.columns.data() + data.mipOffsets[level];
+        for (int x = 0; x < width; ++x) {
+            for (int y = 0; y < height; ++y) {
+                columns[x * height + y] = rows[y * width + x];
+            }
+        }
+    }
+    refreshDesc(handle);
     return true;
 }
 
@@ -216,6 +330,74 @@ bool TextureManager::createCeilingTexture(const std::string& id, int width, int
     return cacheTexturePixels(id, texture);
 }
 
+bool TextureManager::createSpriteTexture(const std::string& id, int size, int type, Uint32 color) {
+    // 알파 0인 픽셀은 투명. 렌더 타깃을 거치면 알파가 보존되지 않을 수 있어 픽셀을 직접 채운다
+    std::vector<Uint32> pixels(size * size, 0);
+    float half = size * 0.5f;
+    Uint32 dark = 0xFF000000 | ((color >> 1) & 0x7F7F7F);
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            // 스프라이트 중앙 기준 -1 ~ 1 좌표 (y는 아래쪽이 +)
+            float u = (x + 0.5f - half) / half;
+            float v = (y + 0.5f - half) / half;
+            float radius = std::sqrt(u * u + v * v);
+            Uint32 texel = 0;
+
+            switch (type) {
+                case 0: { // 열쇠: 고리 + 막대 + 이빨
+                    float ring = std::sqrt(u * u + (v + 0.45f) * (v + 0.45f));
+                    if (ring < 0.35f && ring > 0.18f) texel = color;
+                    else if (std::abs(u) < 0.08f && v > -0.12f && v < 0.85f) texel = color;
+                    else if (u >= 0.08f && u < 0.3f && ((v > 0.45f && v < 0.58f) || (v > 0.7f && v < 0.83f))) texel = dark;
+                    break;
+                }
+                case 1: // 구급상자: 흰 상자에 빨간 십자
+                    if (std::abs(u) < 0.7f && v > -0.2f && v < 0.9f) {
+                        bool cross = (std::abs(u) < 0.12f && v > 0.05f && v < 0.65f) ||
+                                     (std::abs(u) < 0.4f && std::abs(v - 0.35f) < 0.12f);
+                        texel = cross ? 0xFFD02020 : 0xFFE0E0E0;
+                    }
+                    break;
+                case 2: // 탄약 상자: 놋쇠색 탄피 세 개
+                    if (v > 0.7f && v < 0.9f && std::abs(u) < 0.7f) {
+                        texel = dark; // 받침
+                        break;
+                    }
+                    for (int shell = -1; shell <= 1; ++shell) {
+                        float offset = u - shell * 0.4f;
+                        if (std::abs(offset) < 0.13f && v > -0.1f && v <= 0.7f) texel = color;
+                        else if (offset * offset + (v + 0.1f) * (v + 0.1f) < 0.13f * 0.13f) texel = dark;
+                    }
+                    break;
+                case 3: // 출구 포털: 빛나는 고리
+                    if (radius < 0.95f && radius > 0.55f) texel = color;
+                    else if (radius <= 0.55f) texel = 0x80000000 | (dark & 0xFFFFFF);
+                    break;
+                case 4: // 몬스터: 어두운 몸통과 빛나는 두 눈
+                    if (std::sqrt(u * u * 1.6f + (v - 0.15f) * (v - 0.15f)) < 0.85f) {
+                        bool eye = std::sqrt((std::abs(u) - 0.28f) * (std::abs(u) - 0.28f) + (v + 0.15f) * (v + 0.15f)) < 0.12f;
+                        texel = eye ? 0xFFFFE040 : ((x + y) % 7 == 0 ? dark : color);
+                    }
+                    break;
+            }
+            pixels[y * size + x] = texel;
+        }
+    }
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, size, size);
+    if (!texture) {
+        std::cerr << "Failed to create sprite texture - " << SDL_GetError() << std::endl;
+        return false;
+    }
+    SDL_UpdateTexture(texture, NULL, pixels.data(), size * sizeof(Uint32));
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    textures[id] = texture;
+    storeTexturePixels(id, std::move(pixels), size, size);
+    return true;
+}
+
 SDL_Texture* TextureManager::getTexture(const std::string& id) {
     auto it = textures.find(id);
     if (it != textures.end()) {
@@ -224,32 +406,24 @@ SDL_Texture* TextureManager::getTexture(const std::string& id) {
     return nullptr;
 }
 
-const std::vector<Uint32>* TextureManager::getPixels(const std::string& name, int& width, int& height) {
-    auto it = texturePixels.find(name);
-    if (it == texturePixels.end()) {
-        width = 0;
-        height = 0;
-        return nullptr;
+TextureHandle TextureManager::getHandle(const std::string& name) const {
+    auto it = textureHandles.find(name);
+    if (it == textureHandles.end()) {
+        return INVALID_TEXTURE_HANDLE;
     }
-    width = textureWidths[name];
-    height = textureHeights[name];
-    return &it->second;
+    return it->second;
 }
 
-Uint32 TextureManager::sampleTexture(const std::string& name, float u, float v) {
-    auto it = texturePixels.find(name);
-    if (it == texturePixels.end()) {
+Uint32 TextureManager::sampleTexture(TextureHandle handle, float u, float v) const {
+    const TextureDesc* desc = getDesc(handle);
+    if (!desc) {
         return 0xFFFFFFFF; // 흰색 에러 색상
     }
 
-    const auto& pixels = it->second;
-    int width = textureWidths[name];
-    int height = textureHeights[name];
-
-    int texX = static_cast<int>(u * width) % width;
-    int texY = static_cast<int>(v * height) % height;
-    if (texX < 0) texX += width;
-    if (texY < 0) texY += height;
+    int texX = static_cast<int>(u * desc->width) % desc->width;
+    int texY = static_cast<int>(v * desc->height) % desc->height;
+    if (texX < 0) texX += desc->width;
+    if (texY < 0) texY += desc->height;
 
-    return pixels[texY * width + texX];
+    return desc->pixels[texY * desc->width + texX];
 }
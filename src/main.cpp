@@ -1,6 +1,7 @@
 #include "Game.h"
 #include <iostream>
 #include <string>
+#include <cstdlib>
 #include <filesystem>
 #include <SDL2/SDL.h>
 
@@ -30,14 +31,64 @@ std::string findResourcePath() {
 }
 
 
-int main() {
+// 명령줄 인자를 게임 옵션으로 변환
+GameOptions parseOptions(int argc, char* argv[]) {
+    GameOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--raymarch") {
+            options.wallCaster = WallCaster::RayMarch;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.renderThreads = std::atoi(argv[++i]);
+        } else if (arg == "--span-kernel" && i + 1 < argc) {
+            std::string kernel = argv[++i];
+            if (kernel == "scalar") options.spanKernel = SpanKernel::Scalar;
+            else if (kernel == "sse2") options.spanKernel = SpanKernel::SSE2;
+            else if (kernel == "avx2") options.spanKernel = SpanKernel::AVX2;
+            else std::cerr << "Unknown span kernel: " << kernel << std::endl;
+        } else if (arg == "--chunk-budget" && i + 1 < argc) {
+            options.chunkBudget = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.fixedSeed = true;
+            options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--monsters" && i + 1 < argc) {
+            options.monsterCount = std::atoi(argv[++i]);
+        } else if (arg == "--max-fps" && i + 1 < argc) {
+            options.maxFPS = std::atoi(argv[++i]);
+        } else if (arg == "--pipelined") {
+            options.pipelined = true;
+        } else if (arg == "--no-vsync") {
+            options.vsync = false;
+        } else if (arg == "--persist") {
+            options.persistChunks = true;
+        } else if (arg == "--map-dir" && i + 1 < argc) {
+            options.persistChunks = true;
+            options.mapDirectory = argv[++i];
+        } else if (arg == "--no-mipmaps") {
+            options.mipmapping = false;
+        } else if (arg == "--lighting" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "float") options.lightingMode = LightingMode::Float;
+            else if (mode == "fixed") options.lightingMode = LightingMode::FixedPoint;
+            else std::cerr << "Unknown lighting mode: " << mode << std::endl;
+        } else {
+            std::cerr << "Unknown option ignored: " << arg << std::endl;
+        }
+    }
+    return options;
+}
+
+
+int main(int argc, char* argv[]) {
     // 리소스 경로 설정
     std::string resourcePath = findResourcePath();
     std::cout << "Resource path set to: " << resourcePath << std::endl;
 
+    GameOptions options = parseOptions(argc, argv);
+
     Game game;
     
-    if (!game.initialize(resourcePath)) {
+    if (!game.initialize(resourcePath, options)) {
         std::cerr << "Failed to initialize game!" << std::endl;
         return -1;
     }
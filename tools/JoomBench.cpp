@@ -0,0 +1,573 @@
+// Joom 마이크로 벤치마크 (SDL 없이 빌드)
+// 사용법: JoomBench [benchmark...]   인자가 없으면 전체 실행
+#include "FlowField.h"
+#include "LightGrid.h"
+#include "Map.h"
+#include "MapGenerator.h"
+#include "MonsterSystem.h"
+#include "Pathfinder.h"
+#include "PerlinBatch.h"
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const unsigned int BENCH_SEED = 12345;
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 맵 생성 중 출력되는 로그를 숨긴다
+struct QuietCout {
+    std::ostringstream sink;
+    std::streambuf* previous;
+    QuietCout() : previous(std::cout.rdbuf(sink.rdbuf())) {}
+    ~QuietCout() { restore(); }
+    void restore() {
+        if (previous) std::cout.rdbuf(previous);
+        previous = nullptr;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// chunk-lookup: Map::getWallType 처리량, 예전 std::map 경로와 비교
+
+// 예전 구현 (std::map<std::pair<int,int>, Chunk> + float floor 나눗셈)
+int legacyGetWallType(const std::map<std::pair<int, int>, Chunk>& chunks, int x, int y) {
+    int chunkX = floor(static_cast<float>(x) / CHUNK_SIZE);
+    int chunkY = floor(static_cast<float>(y) / CHUNK_SIZE);
+    auto it = chunks.find({chunkX, chunkY});
+    if (it == chunks.end()) return 1;
+    int tileX = x % CHUNK_SIZE;
+    int tileY = y % CHUNK_SIZE;
+    if (tileX < 0) tileX += CHUNK_SIZE;
+    if (tileY < 0) tileY += CHUNK_SIZE;
+    return it->second.tiles[tileY][tileX];
+}
+
+void benchChunkLookup() {
+    const int radius = 4;  // (2*radius+1)^2 청크
+    const int rayCount = 200000;
+    const int raySteps = 20;
+
+    QuietCout quiet;
+    Map map(BENCH_SEED);
+    for (int cy = -radius; cy <= radius; ++cy) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            map.generateChunkNow(cx, cy);
+        }
+    }
+
+    std::map<std::pair<int, int>, Chunk> legacyChunks;
+    for (int cy = -radius; cy <= radius; ++cy) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            if (const Chunk* chunk = map.findChunk(cx, cy)) legacyChunks[{cx, cy}] = *chunk;
+        }
+    }
+
+    // 렌더러와 비슷한 접근 패턴: 임의의 시작점에서 광선을 따라 한 칸씩 전진
+    std::vector<std::pair<int, int>> queries;
+    queries.reserve(static_cast<size_t>(rayCount) * raySteps);
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_real_distribution<float> position(-radius * CHUNK_SIZE, (radius + 1) * CHUNK_SIZE);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    for (int r = 0; r < rayCount; ++r) {
+        float x = position(rng), y = position(rng), a = angle(rng);
+        float dx = std::cos(a), dy = std::sin(a);
+        for (int s = 0; s < raySteps; ++s) {
+            queries.emplace_back(static_cast<int>(std::floor(x + dx * s)), static_cast<int>(std::floor(y + dy * s)));
+        }
+    }
+
+    long long legacySum = 0, newSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& q : queries) legacySum += legacyGetWallType(legacyChunks, q.first, q.second);
+    double legacyTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& q : queries) newSum += map.getWallType(q.first, q.second);
+    double newTime = secondsSince(start);
+
+    double count = static_cast<double>(queries.size());
+    quiet.restore();
+    std::cout << "chunk-lookup: " << queries.size() << " lookups over " << legacyChunks.size() << " chunks" << std::endl;
+    std::cout << "  std::map   " << count / legacyTime / 1e6 << " M lookups/s" << std::endl;
+    std::cout << "  ChunkTable " << count / newTime / 1e6 << " M lookups/s"
+              << " (x" << legacyTime / newTime << ")" << std::endl;
+    if (legacySum != newSum) {
+        std::cerr << "chunk-lookup: results differ (" << legacySum << " vs " << newSum << ")" << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// perlin: 청크 생성 속도, 배치 평가기와 타일별 octave2D_01 비교
+
+void benchPerlin() {
+    const int side = 48; // side x side 청크
+    const float tolerance = 1e-4f;
+    MapGenerator generator(BENCH_SEED);
+
+    std::vector<Chunk> reference(side * side), batched(side * side);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < side * side; ++i) {
+        generator.generateChunkReference(i % side - side / 2, i / side - side / 2, reference[i]);
+    }
+    double referenceTime = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < side * side; ++i) {
+        generator.generateChunk(i % side - side / 2, i / side - side / 2, batched[i]);
+    }
+    double batchTime = secondsSince(start);
+
+    // 노이즈 값 자체의 오차
+    PerlinBatch batch(generator.getNoise().serialize());
+    float noise[CHUNK_SIZE * CHUNK_SIZE];
+    double maxError = 0.0;
+    long long tileMismatches = 0;
+    for (int i = 0; i < side * side; ++i) {
+        int chunkX = i % side - side / 2, chunkY = i / side - side / 2;
+        batch.octave2D_01(chunkX * CHUNK_SIZE, chunkY * CHUNK_SIZE, generator.getFrequency(), CHUNK_SIZE, CHUNK_SIZE,
+                          generator.getOctaves(), 0.5f, noise);
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                double expected = generator.getNoise().octave2D_01((chunkX * CHUNK_SIZE + x) * generator.getFrequency(),
+                                                                   (chunkY * CHUNK_SIZE + y) * generator.getFrequency(),
+                                                                   generator.getOctaves());
+                maxError = std::max(maxError, std::abs(expected - noise[y * CHUNK_SIZE + x]));
+                tileMismatches += reference[i].tiles[y][x] != batched[i].tiles[y][x];
+            }
+        }
+    }
+
+    double chunks = static_cast<double>(side * side);
+    std::cout << "perlin: " << side * side << " chunks" << std::endl;
+    std::cout << "  scalar octave2D_01 " << chunks / referenceTime << " chunks/s" << std::endl;
+    std::cout << "  PerlinBatch        " << chunks / batchTime << " chunks/s"
+              << " (x" << referenceTime / batchTime << ")" << std::endl;
+    std::cout << "  max noise error " << maxError << ", tiles differing " << tileMismatches << " of "
+              << side * side * CHUNK_SIZE * CHUNK_SIZE << std::endl;
+    if (maxError > tolerance) {
+        std::cerr << "perlin: error exceeds tolerance " << tolerance << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// flow-field: 같은 플레이어를 쫓는 몬스터 무리. 몬스터별 A*와 공유 거리 지도 비교
+
+void benchFlowField() {
+    const int radius = 4;
+    const int monsterCount = 500;
+    const int frames = 20;
+
+    QuietCout quiet;
+    Map map(BENCH_SEED);
+    for (int cy = -radius; cy <= radius; ++cy) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            map.generateChunkNow(cx, cy);
+        }
+    }
+
+    // 플레이어는 원점 근처의 빈 칸, 몬스터는 그 주변 24칸 이내의 빈 칸 (추격 범위보다 넉넉하게)
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_int_distribution<int> offset(-24, 24);
+    int playerX = 0, playerY = 0;
+    while (map.isWallAt(playerX, playerY)) ++playerX;
+    std::vector<std::pair<int, int>> monsters;
+    while (static_cast<int>(monsters.size()) < monsterCount) {
+        int x = playerX + offset(rng), y = playerY + offset(rng);
+        if (!map.isWallAt(x, y)) monsters.emplace_back(x, y);
+    }
+
+    // 매 프레임 플레이어가 한 칸씩 움직이는 최악의 경우 (거리 지도도 매번 다시 계산)
+    Pathfinder pathfinder;
+    std::vector<PathPoint> path;
+    int pathsFound = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (const auto& monster : monsters) {
+            pathsFound += pathfinder.findPath(monster.first, monster.second, playerX + (frame & 1), playerY, &map, path);
+        }
+    }
+    double astarTime = secondsSince(start);
+
+    FlowField flowField;
+    int directionsFound = 0;
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        flowField.update(&map, playerX + (frame & 1) + 0.5f, playerY + 0.5f);
+        for (const auto& monster : monsters) {
+            float dirX, dirY;
+            directionsFound += flowField.getDirection(monster.first + 0.5f, monster.second + 0.5f, dirX, dirY);
+        }
+    }
+    double flowTime = secondsSince(start);
+
+    quiet.restore();
+    std::cout << "flow-field: " << monsterCount << " monsters, " << frames << " frames, field "
+              << FlowField::FIELD_SIZE << "x" << FlowField::FIELD_SIZE << std::endl;
+    std::cout << "  per-monster A* " << astarTime / frames * 1e3 << " ms/frame (" << pathsFound / frames
+              << " paths)" << std::endl;
+    std::cout << "  FlowField      " << flowTime / frames * 1e3 << " ms/frame (" << directionsFound / frames
+              << " directions, " << flowField.getRebuildCount() << " rebuilds, x" << astarTime / flowTime << ")"
+              << std::endl;
+    if (pathsFound != directionsFound) {
+        std::cerr << "flow-field: reachable monsters differ (" << pathsFound << " vs " << directionsFound << ")"
+                  << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// jps: 생성된 동굴에서 임의의 시작/목적지 쌍, A*와 Jump Point Search의 확장 수와 시간 비교
+
+float pathCost(const std::vector<PathPoint>& path) {
+    float cost = 0.0f;
+    for (size_t i = 1; i < path.size(); ++i) {
+        bool diagonal = path[i].x != path[i - 1].x && path[i].y != path[i - 1].y;
+        cost += diagonal ? 1.41421356f : 1.0f;
+    }
+    return cost;
+}
+
+void benchJumpPoint() {
+    const int radius = 5;
+    const int queryCount = 20000;
+    const int maxOffset = Pathfinder::HIERARCHICAL_DISTANCE; // 탐색 창 안에서 끝나는 거리만
+
+    QuietCout quiet;
+    Map map(BENCH_SEED);
+    for (int cy = -radius; cy <= radius; ++cy) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            map.generateChunkNow(cx, cy);
+        }
+    }
+
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_int_distribution<int> position(-(radius - 1) * CHUNK_SIZE, radius * CHUNK_SIZE - 1);
+    std::uniform_int_distribution<int> offset(-maxOffset, maxOffset);
+    std::vector<std::pair<PathPoint, PathPoint>> queries;
+    while (static_cast<int>(queries.size()) < queryCount) {
+        PathPoint start = {position(rng), position(rng)};
+        PathPoint end = {start.x + offset(rng), start.y + offset(rng)};
+        if (!map.isWallAt(start.x, start.y) && !map.isWallAt(end.x, end.y)) queries.push_back({start, end});
+    }
+
+    struct Result {
+        double time = 0.0;
+        long long expansions = 0;
+        int found = 0;
+        std::vector<float> costs;
+    };
+    auto run = [&](PathStrategy strategy, Result& result) {
+        Pathfinder pathfinder;
+        pathfinder.setStrategy(strategy);
+        std::vector<PathPoint> path;
+        result.costs.reserve(queries.size());
+        for (const auto& query : queries) {
+            auto start = std::chrono::steady_clock::now();
+            bool found = pathfinder.findPath(query.first.x, query.first.y, query.second.x, query.second.y, &map, path);
+            result.time += secondsSince(start);
+            result.expansions += pathfinder.getLastExpansions();
+            result.found += found;
+            result.costs.push_back(found ? pathCost(path) : -1.0f);
+        }
+    };
+    Result astar, jps;
+    run(PathStrategy::AStar, astar);
+    run(PathStrategy::JumpPoint, jps);
+
+    int costMismatches = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (std::abs(astar.costs[i] - jps.costs[i]) > 1e-3f) ++costMismatches;
+    }
+
+    double count = static_cast<double>(queries.size());
+    quiet.restore();
+    std::cout << "jps: " << queries.size() << " queries (up to " << maxOffset << " tiles apart), "
+              << astar.found << " reachable" << std::endl;
+    std::cout << "  A*  " << astar.time / count * 1e6 << " us/query, " << astar.expansions / count
+              << " expansions/query" << std::endl;
+    std::cout << "  JPS " << jps.time / count * 1e6 << " us/query, " << jps.expansions / count
+              << " expansions/query (x" << astar.time / jps.time << ")" << std::endl;
+    if (costMismatches > 0 || astar.found != jps.found) {
+        std::cerr << "jps: " << costMismatches << " path costs differ from A*" << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// light-grid: 점광원 격자 갱신 비용과, 픽셀마다 모든 광원을 평가하는 경우(차폐 없이도)와의 비교
+
+void benchLightGrid() {
+    const int radius = 3;
+    const int lightCount = 64;
+    const int movingLights = 4;
+    const int frames = 100;
+    const int pixelCount = 800 * 300; // 바닥 절반 화면
+
+    QuietCout quiet;
+    Map map(BENCH_SEED);
+    for (int cy = -radius; cy <= radius; ++cy) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            map.generateChunkNow(cx, cy);
+        }
+    }
+
+    struct PointLight {
+        float x, y, radius, intensity;
+    };
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_real_distribution<float> position(-(radius - 1) * CHUNK_SIZE, radius * CHUNK_SIZE);
+    std::vector<PointLight> lights;
+    while (static_cast<int>(lights.size()) < lightCount) {
+        float x = position(rng), y = position(rng);
+        if (!map.isWallAt(x, y)) lights.push_back({x, y, 8.0f, 0.6f});
+    }
+
+    LightGrid grid;
+    std::vector<int> ids;
+    for (const PointLight& light : lights) ids.push_back(grid.addLight(light.x, light.y, light.radius, light.intensity));
+    auto start = std::chrono::steady_clock::now();
+    grid.update(&map);
+    double buildTime = secondsSince(start);
+
+    // 아무것도 바뀌지 않은 프레임 (리비전 확인만)
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) grid.update(&map);
+    double idleTime = secondsSince(start);
+
+    // 몇 개의 광원(횃불을 든 몬스터)이 매 프레임 움직이는 경우
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < movingLights; ++i) {
+            grid.moveLight(ids[i], lights[i].x + (frame & 1) * 0.25f, lights[i].y);
+        }
+        grid.update(&map);
+    }
+    double movingTime = secondsSince(start);
+
+    // 렌더러처럼 한 행씩 이어지는 좌표 (행마다 임의의 시작점과 방향)
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<std::pair<float, float>> pixels;
+    pixels.reserve(pixelCount);
+    while (static_cast<int>(pixels.size()) < pixelCount) {
+        float x = position(rng), y = position(rng), a = angle(rng);
+        for (int i = 0; i < 800; ++i) pixels.emplace_back(x + i * 0.02f * std::cos(a), y + i * 0.02f * std::sin(a));
+    }
+
+    LightGridSampler sampler(grid);
+    float gridSum = 0.0f;
+    start = std::chrono::steady_clock::now();
+    for (const auto& pixel : pixels) {
+        gridSum += sampler.sample(static_cast<int>(std::floor(pixel.first)), static_cast<int>(std::floor(pixel.second)));
+    }
+    double gridTime = secondsSince(start);
+
+    float naiveSum = 0.0f;
+    start = std::chrono::steady_clock::now();
+    for (const auto& pixel : pixels) {
+        for (const PointLight& light : lights) {
+            float dx = pixel.first - light.x, dy = pixel.second - light.y;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            if (distance < light.radius) {
+                float falloff = 1.0f - distance / light.radius;
+                naiveSum += light.intensity * falloff * falloff;
+            }
+        }
+    }
+    double naiveTime = secondsSince(start);
+
+    quiet.restore();
+    std::cout << "light-grid: " << lightCount << " lights (radius 8), " << grid.getLitChunkCount()
+              << " lit chunks" << std::endl;
+    std::cout << "  full build     " << buildTime * 1e3 << " ms" << std::endl;
+    std::cout << "  idle update    " << idleTime / frames * 1e6 << " us/frame" << std::endl;
+    std::cout << "  " << movingLights << " moving      " << movingTime / frames * 1e3 << " ms/frame" << std::endl;
+    std::cout << "  grid sampling  " << gridTime * 1e3 << " ms/frame (" << pixelCount << " pixels)" << std::endl;
+    std::cout << "  per-pixel eval " << naiveTime * 1e3 << " ms/frame without occlusion (x" << naiveTime / gridTime
+              << ")" << std::endl;
+    std::cout << "  mean light     grid " << gridSum / pixelCount << ", per-pixel " << naiveSum / pixelCount
+              << " (grid includes wall occlusion)" << std::endl;
+}
+
+// ---------------------------------------------------------------------------
+// spatial-grid: 넓은 월드에 흩어진 엔티티에 대한 줍기 판정 (반경 질의)과 이동, 전수 검사와 비교
+
+void benchSpatialGrid() {
+    const int entityCount = 100000;
+    const float worldHalfSize = 2000.0f;
+    const int queryCount = 100000;
+    const float pickupRadius = 0.3f;
+
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_real_distribution<float> position(-worldHalfSize, worldHalfSize);
+    std::vector<std::pair<float, float>> entities(entityCount);
+    for (auto& entity : entities) entity = {position(rng), position(rng)};
+
+    SpatialGrid grid;
+    std::vector<int> handles;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < entityCount; ++i) {
+        handles.push_back(grid.insert(entities[i].first, entities[i].second, SPATIAL_LAYER_ITEM, i));
+    }
+    double insertTime = secondsSince(start);
+
+    // 질의 지점의 절반은 엔티티 바로 옆 (실제로 줍는 경우)
+    std::vector<std::pair<float, float>> queries(queryCount);
+    for (int i = 0; i < queryCount; ++i) {
+        const auto& near = entities[rng() % entityCount];
+        queries[i] = (i & 1) ? std::make_pair(near.first + 0.1f, near.second) : std::make_pair(position(rng), position(rng));
+    }
+
+    std::vector<int> results;
+    long long gridHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& query : queries) {
+        grid.queryRadius(query.first, query.second, pickupRadius, SPATIAL_LAYER_ITEM, results);
+        gridHits += results.size();
+    }
+    double gridTime = secondsSince(start);
+
+    // 예전 ItemManager::checkItemCollision 방식 (모든 엔티티에 sqrt 거리 검사). 너무 느려서 일부만 측정
+    const int linearQueries = 1000;
+    long long linearHits = 0, sampledGridHits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < linearQueries; ++q) {
+        for (const auto& entity : entities) {
+            float dx = entity.first - queries[q].first;
+            float dy = entity.second - queries[q].second;
+            if (std::sqrt(dx * dx + dy * dy) < pickupRadius) ++linearHits;
+        }
+        grid.queryRadius(queries[q].first, queries[q].second, pickupRadius, SPATIAL_LAYER_ITEM, results);
+        sampledGridHits += results.size();
+    }
+    double linearTime = secondsSince(start);
+
+    // 모든 엔티티가 조금씩 움직이는 프레임 (몬스터 무리)
+    std::uniform_real_distribution<float> step(-0.1f, 0.1f);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < entityCount; ++i) {
+        entities[i].first += step(rng);
+        entities[i].second += step(rng);
+        grid.move(handles[i], entities[i].first, entities[i].second);
+    }
+    double moveTime = secondsSince(start);
+
+    std::cout << "spatial-grid: " << entityCount << " entities in " << worldHalfSize * 2 << "x" << worldHalfSize * 2
+              << " tiles, " << grid.getCellCount() << " cells" << std::endl;
+    std::cout << "  insert         " << insertTime * 1e9 / entityCount << " ns/entity" << std::endl;
+    std::cout << "  radius query   " << gridTime * 1e9 / queryCount << " ns/query (" << gridHits << " hits)" << std::endl;
+    std::cout << "  linear scan    " << linearTime * 1e9 / linearQueries << " ns/query (x"
+              << (linearTime / linearQueries) / (gridTime / queryCount) << ")" << std::endl;
+    std::cout << "  move all       " << moveTime * 1e3 << " ms" << std::endl;
+    if (linearHits != sampledGridHits) {
+        std::cerr << "spatial-grid: hit counts differ (" << linearHits << " vs " << sampledGridHits << ")" << std::endl;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// monsters: 생성된 동굴에 N마리를 풀어 놓고 MonsterSystem::update 처리량 (LOD 끔/켬)
+
+void benchMonsters() {
+    const int radius = 4;
+    const int monsterCount = 10000;
+    const int frames = 300;
+    const float deltaTime = 1.0f / 60.0f;
+
+    QuietCout quiet;
+    Map map(BENCH_SEED);
+    for (int cy = -radius; cy <= radius; ++cy) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            map.generateChunkNow(cx, cy);
+        }
+    }
+    quiet.restore();
+
+    // 로드된 영역 전체의 빈 타일에 고르게 흩어 놓는다
+    const int extent = (radius + 1) * CHUNK_SIZE;
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_int_distribution<int> tile(-radius * CHUNK_SIZE, extent - 1);
+    std::vector<std::pair<int, int>> spawnTiles;
+    while (static_cast<int>(spawnTiles.size()) < monsterCount) {
+        int x = tile(rng), y = tile(rng);
+        if (!map.isWallAt(x, y)) spawnTiles.emplace_back(x, y);
+    }
+    int playerX = 0, playerY = 0;
+    while (map.isWallAt(playerX, playerY)) ++playerX;
+
+    std::cout << "monsters: " << monsterCount << " agents on " << (2 * radius + 1) * CHUNK_SIZE << "x"
+              << (2 * radius + 1) * CHUNK_SIZE << " tiles, " << frames << " updates" << std::endl;
+    double baseline = 0.0;
+    for (bool levelOfDetail : {false, true}) {
+        SpatialGrid grid;
+        MonsterSystem monsters(&grid, BENCH_SEED);
+        monsters.setLevelOfDetail(levelOfDetail);
+        for (const auto& spawnTile : spawnTiles) monsters.spawn(spawnTile.first + 0.5f, spawnTile.second + 0.5f);
+
+        // 플레이어는 0.5초마다 옆 칸으로 옮겨 가며 거리 지도를 계속 다시 계산하게 한다
+        long long agentTicks = 0;
+        int chasing = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            float x = playerX + ((frame / 30) & 1) + 0.5f;
+            monsters.update(&map, x, playerY + 0.5f, deltaTime);
+            agentTicks += monsters.getLastTickCount();
+        }
+        double elapsed = secondsSince(start);
+        for (int i = 0; i < monsters.getCount(); ++i) chasing += monsters.getState(i) != MonsterState::IDLE;
+        if (!levelOfDetail) baseline = elapsed;
+
+        std::cout << (levelOfDetail ? "  LOD on   " : "  LOD off  ") << agentTicks / elapsed / 1e6
+                  << " M agent ticks/s, " << elapsed / frames * 1e3 << " ms/update, " << agentTicks / frames
+                  << " agent ticks/update, " << chasing << " chasing";
+        if (levelOfDetail) std::cout << " (x" << baseline / elapsed << " per update)";
+        std::cout << std::endl;
+    }
+}
+
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+const Benchmark BENCHMARKS[] = {
+    {"chunk-lookup", benchChunkLookup},
+    {"perlin", benchPerlin},
+    {"flow-field", benchFlowField},
+    {"jps", benchJumpPoint},
+    {"light-grid", benchLightGrid},
+    {"spatial-grid", benchSpatialGrid},
+    {"monsters", benchMonsters},
+};
+
+}
+
+int main(int argc, char* argv[]) {
+    bool ranAny = false;
+    for (const Benchmark& benchmark : BENCHMARKS) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], benchmark.name) == 0) selected = true;
+        }
+        if (selected) {
+            benchmark.run();
+            ranAny = true;
+        }
+    }
+    if (!ranAny) {
+        std::cerr << "Unknown benchmark. Available:";
+        for (const Benchmark& benchmark : BENCHMARKS) std::cerr << " " << benchmark.name;
+        std::cerr << std::endl;
+        return 1;
+    }
+    return 0;
+}